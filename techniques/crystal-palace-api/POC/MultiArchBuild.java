@@ -0,0 +1,241 @@
+/*
+ * Crystal Palace Multi-Architecture Build Driver
+ *
+ * Builds every architecture section (x64:, x86:) of one or more
+ * specification files, e.g. Example 8 of example_specification.txt:
+ *
+ *   - each spec is parsed once and all of its targets build from that
+ *     parsed spec
+ *   - targets build in parallel, on one pool shared by every spec
+ *   - a target whose inputs did not change is skipped. Its fingerprint is
+ *     SHA-256 over the arch section (comments and blank lines dropped, so
+ *     flags and commands count, edits to comments don't) and every file
+ *     the section loads (objects, appended resources like payload.bin,
+ *     mergelib archives). It is kept next to the output as <output>.stamp.
+ *
+ * Outputs go to each section's link "..." path. load/mergelib/link paths
+ * are relative to the spec. A spec whose targets are all up to date is
+ * not parsed at all.
+ *
+ * Usage:
+ *   javac -cp crystalpalace.jar MultiArchBuild.java
+ *   java -cp crystalpalace.jar:. MultiArchBuild spec.txt [more.spec ...] \
+ *       [--jobs N] [--arch x64,x86] [--force]
+ *
+ * --jobs 1 builds one target at a time (same parse sharing and skipping).
+ */
+
+import crystalpalace.LinkSpec;
+import crystalpalace.SpecParser;
+
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.security.MessageDigest;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HexFormat;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+public class MultiArchBuild {
+    static final Pattern LABEL = Pattern.compile("^(x64|x86):\\s*$");
+    static final Pattern INPUT = Pattern.compile("^\\s*(load|mergelib)\\s+\"([^\"]+)\"");
+    static final Pattern LINK = Pattern.compile("^\\s*link\\s+\"([^\"]+)\"");
+
+    static class Target {
+        Path spec;
+        String arch;
+        StringBuilder section = new StringBuilder();    // Normalized text
+        List<Path> inputs = new ArrayList<>();
+        Path output;
+        String fingerprint;
+        String status = "pending";
+        long millis;
+    }
+
+    static String stripComment(String line) {
+        // Keep '#' inside quoted paths
+        boolean quoted = false;
+        for (int i = 0; i < line.length(); i++) {
+            char c = line.charAt(i);
+            if (c == '"') quoted = !quoted;
+            else if (c == '#' && !quoted) return line.substring(0, i);
+        }
+        return line;
+    }
+
+    // One pass over the text: per-arch sections, their inputs and outputs
+    static List<Target> scan(Path spec, String text) {
+        Map<String, Target> targets = new LinkedHashMap<>();
+        Path dir = spec.toAbsolutePath().getParent();
+        Target current = null;
+
+        for (String raw : text.split("\\R")) {
+            String line = stripComment(raw).stripTrailing();
+            if (line.isBlank()) continue;
+
+            Matcher label = LABEL.matcher(line);
+            if (label.matches()) {
+                String arch = label.group(1);
+                if (targets.containsKey(arch)) {
+                    throw new IllegalArgumentException(spec + ": " + arch + " appears twice");
+                }
+                current = new Target();
+                current.spec = spec;
+                current.arch = arch;
+                targets.put(arch, current);
+                continue;
+            }
+
+            if (current == null) continue;
+            current.section.append(line.strip()).append('\n');
+
+            Matcher input = INPUT.matcher(line);
+            if (input.find()) current.inputs.add(dir.resolve(input.group(2)));
+
+            Matcher link = LINK.matcher(line);
+            if (link.find()) current.output = dir.resolve(link.group(1));
+        }
+
+        for (Target target : targets.values()) {
+            if (target.output == null) {
+                throw new IllegalArgumentException(spec + ": " + target.arch + " has no link");
+            }
+        }
+
+        return new ArrayList<>(targets.values());
+    }
+
+    // Missing inputs hash as such, so the build runs and reports them
+    static String fingerprint(Target target) throws Exception {
+        MessageDigest digest = MessageDigest.getInstance("SHA-256");
+        digest.update(target.arch.getBytes(StandardCharsets.UTF_8));
+        digest.update(target.section.toString().getBytes(StandardCharsets.UTF_8));
+
+        for (Path input : target.inputs) {
+            digest.update(input.toString().getBytes(StandardCharsets.UTF_8));
+            digest.update(Files.exists(input) ? Files.readAllBytes(input) : new byte[] { 0 });
+        }
+
+        return HexFormat.of().formatHex(digest.digest());
+    }
+
+    static Path stampOf(Target target) {
+        return target.output.resolveSibling(target.output.getFileName() + ".stamp");
+    }
+
+    static boolean upToDate(Target target) throws Exception {
+        Path stamp = stampOf(target);
+        return Files.exists(target.output) && Files.exists(stamp)
+            && Files.readString(stamp).strip().equals(target.fingerprint);
+    }
+
+    static LinkSpec parse(Path spec, String text) {
+        try {
+            var parser = new SpecParser();
+            parser.parse(text, spec.toAbsolutePath().toString());
+            return parser.getSpec();
+        } catch (Exception e) {
+            throw new RuntimeException(spec + ": " + e.getMessage(), e);
+        }
+    }
+
+    static void build(LinkSpec spec, Target target) {
+        long start = System.nanoTime();
+        try {
+            byte[] pic = spec.buildPic(target.arch, new HashMap<String, Object>());
+            Files.write(target.output, pic);
+
+            // Stamp last: an interrupted build rebuilds next time
+            Files.writeString(stampOf(target), target.fingerprint + "\n");
+            target.status = "built " + pic.length + " bytes";
+        } catch (Exception e) {
+            target.status = "FAILED: " + e.getMessage();
+        }
+        target.millis = (System.nanoTime() - start) / 1_000_000;
+    }
+
+    public static void main(String[] argv) throws Exception {
+        List<Path> specs = new ArrayList<>();
+        Set<String> arches = Set.of("x64", "x86");
+        int jobs = Runtime.getRuntime().availableProcessors();
+        boolean force = false;
+
+        for (int i = 0; i < argv.length; i++) {
+            switch (argv[i]) {
+                case "--jobs" -> jobs = Integer.parseInt(argv[++i]);
+                case "--arch" -> arches = Set.of(argv[++i].split(","));
+                case "--force" -> force = true;
+                default -> specs.add(Path.of(argv[i]));
+            }
+        }
+
+        if (specs.isEmpty() || jobs < 1) {
+            System.err.println("usage: MultiArchBuild <spec.txt> [more.spec ...] "
+                + "[--jobs N] [--arch x64,x86] [--force]");
+            System.exit(1);
+        }
+
+        long start = System.nanoTime();
+        ExecutorService pool = Executors.newFixedThreadPool(jobs);
+        List<Target> all = new ArrayList<>();
+        List<CompletableFuture<Void>> pending = new ArrayList<>();
+
+        for (Path spec : specs) {
+            String text = Files.readString(spec);
+            List<Target> stale = new ArrayList<>();
+
+            for (Target target : scan(spec, text)) {
+                if (!arches.contains(target.arch)) continue;
+                all.add(target);
+
+                target.fingerprint = fingerprint(target);
+                if (!force && upToDate(target)) {
+                    target.status = "up to date";
+                } else {
+                    stale.add(target);
+                }
+            }
+
+            if (stale.isEmpty()) continue;
+
+            // Parse once; each stale arch builds from the same spec
+            CompletableFuture<LinkSpec> parsed =
+                CompletableFuture.supplyAsync(() -> parse(spec, text), pool);
+
+            for (Target target : stale) {
+                pending.add(parsed.handleAsync((linkSpec, error) -> {
+                    if (error != null) {
+                        Throwable cause = error.getCause() != null ? error.getCause() : error;
+                        target.status = "FAILED: " + cause.getMessage();
+                    } else {
+                        build(linkSpec, target);
+                    }
+                    return null;
+                }, pool));
+            }
+        }
+
+        CompletableFuture.allOf(pending.toArray(new CompletableFuture[0])).join();
+        pool.shutdown();
+
+        int failed = 0;
+        for (Target target : all) {
+            if (target.status.startsWith("FAILED")) failed++;
+            System.out.printf("%-4s %-40s %6d ms  %s%n",
+                target.arch, target.output.getFileName(), target.millis, target.status);
+        }
+
+        System.out.printf("%d targets, %d failed, %d ms%n",
+            all.size(), failed, (System.nanoTime() - start) / 1_000_000);
+        System.exit(failed == 0 ? 0 : 1);
+    }
+}
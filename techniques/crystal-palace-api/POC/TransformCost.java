@@ -0,0 +1,179 @@
+/*
+ * Crystal Palace Transform Cost Measurement
+ *
+ * Links one object (capability.x64.o from Example 1 of
+ * example_specification.txt) with every combination of +optimize,
+ * +disco, +mutate and +gofirst, and records for each:
+ *
+ *   size    - output bytes over several builds (mutate/disco are
+ *             randomized, so min/mean/max)
+ *   runtime - go() under tradecraft-debugging/POC/pic_runner.exe
+ *
+ * go() must sit at offset 0 to be timed, so variants without +gofirst
+ * are timed from a companion build with +gofirst added (+gofirst's own
+ * cost shows up in its rows).
+ *
+ * Usage:
+ *   javac -cp crystalpalace.jar TransformCost.java
+ *   java -cp crystalpalace.jar:. TransformCost capability.x64.o \
+ *       [--runner pic_runner.exe] [--builds 5] [--samples 200] [--out transform_costs.csv]
+ *
+ * Without --runner only sizes are measured (e.g. building on Linux).
+ */
+
+import crystalpalace.SpecParser;
+
+import java.io.BufferedReader;
+import java.io.InputStreamReader;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Locale;
+
+public class TransformCost {
+    static final String[] TRANSFORMS = { "optimize", "disco", "mutate", "gofirst" };
+    static final int GOFIRST = 1 << 3;
+
+    // Example 1, with the object passed in instead of loaded by name
+    static final String SPEC_TEMPLATE = """
+        x64:
+          push $OBJECT
+          dfr "resolve" "ror13"
+          make pic %s
+        """;
+
+    static class Variant {
+        int mask;
+        String flags;
+        int sizeMin = Integer.MAX_VALUE;
+        int sizeMax;
+        double sizeMean;
+        double p50Ns = Double.NaN;
+        double p99Ns = Double.NaN;
+    }
+
+    static String flagsOf(int mask) {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < TRANSFORMS.length; i++) {
+            if ((mask & (1 << i)) != 0) {
+                if (sb.length() > 0) sb.append(' ');
+                sb.append('+').append(TRANSFORMS[i]);
+            }
+        }
+        return sb.toString();
+    }
+
+    static byte[] build(byte[] object, String flags) throws Exception {
+        var parser = new SpecParser();
+        parser.parse(String.format(SPEC_TEMPLATE, flags), "transform-cost.spec");
+        var spec = parser.getSpec();
+
+        var args = new HashMap<String, Object>();
+        args.put("$OBJECT", object);
+        return spec.buildPic("x64", args);
+    }
+
+    // Runs pic_runner --csv: size,samples,min_ns,p50_ns,p90_ns,p99_ns,p50_cycles
+    static void time(Variant variant, Path runner, Path blob, int samples) throws Exception {
+        Process process = new ProcessBuilder(
+                runner.toString(), blob.toString(), Integer.toString(samples), "--csv")
+            .redirectErrorStream(true)
+            .start();
+
+        String last = null;
+        try (var reader = new BufferedReader(new InputStreamReader(process.getInputStream()))) {
+            for (String line; (line = reader.readLine()) != null; ) last = line;
+        }
+
+        if (process.waitFor() != 0 || last == null) {
+            System.err.println("runner failed for [" + variant.flags + "]: " + last);
+            return;
+        }
+
+        String[] fields = last.split(",");
+        variant.p50Ns = Double.parseDouble(fields[3]);
+        variant.p99Ns = Double.parseDouble(fields[5]);
+    }
+
+    static String percent(double value, double base) {
+        if (Double.isNaN(value) || Double.isNaN(base) || base == 0) return "";
+        return String.format(Locale.ROOT, "%+.1f%%", (value - base) * 100.0 / base);
+    }
+
+    public static void main(String[] argv) throws Exception {
+        Path object = null;
+        Path runner = null;
+        Path out = Path.of("transform_costs.csv");
+        int builds = 5;
+        int samples = 200;
+
+        for (int i = 0; i < argv.length; i++) {
+            switch (argv[i]) {
+                case "--runner" -> runner = Path.of(argv[++i]);
+                case "--builds" -> builds = Integer.parseInt(argv[++i]);
+                case "--samples" -> samples = Integer.parseInt(argv[++i]);
+                case "--out" -> out = Path.of(argv[++i]);
+                default -> object = Path.of(argv[i]);
+            }
+        }
+
+        if (object == null || builds < 1) {
+            System.err.println("usage: TransformCost <object.o> [--runner pic_runner.exe] "
+                + "[--builds N] [--samples N] [--out file.csv]");
+            System.exit(1);
+        }
+
+        byte[] bytes = Files.readAllBytes(object);
+        Path work = Files.createTempDirectory("transform-cost");
+        List<Variant> variants = new ArrayList<>();
+
+        for (int mask = 0; mask < (1 << TRANSFORMS.length); mask++) {
+            Variant variant = new Variant();
+            variant.mask = mask;
+            variant.flags = flagsOf(mask);
+
+            long total = 0;
+            for (int b = 0; b < builds; b++) {
+                int size = build(bytes, variant.flags).length;
+                variant.sizeMin = Math.min(variant.sizeMin, size);
+                variant.sizeMax = Math.max(variant.sizeMax, size);
+                total += size;
+            }
+            variant.sizeMean = (double) total / builds;
+
+            if (runner != null) {
+                Path blob = work.resolve("variant_" + mask + ".bin");
+                Files.write(blob, build(bytes, flagsOf(mask | GOFIRST)));
+                time(variant, runner, blob, samples);
+            }
+
+            variants.add(variant);
+        }
+
+        Variant base = variants.get(0);
+
+        System.out.printf("%-36s %8s %8s %8s %8s %10s %10s %8s%n",
+            "transforms", "min", "mean", "max", "size", "p50 ns", "p99 ns", "time");
+
+        StringBuilder csv = new StringBuilder(
+            "transforms,builds,size_min,size_mean,size_max,size_delta_pct,go_p50_ns,go_p99_ns,time_delta_pct\n");
+
+        for (Variant v : variants) {
+            String name = v.flags.isEmpty() ? "(none)" : v.flags;
+            String sizeDelta = percent(v.sizeMean, base.sizeMean);
+            String timeDelta = percent(v.p50Ns, base.p50Ns);
+
+            System.out.printf(Locale.ROOT, "%-36s %8d %8.0f %8d %8s %10.1f %10.1f %8s%n",
+                name, v.sizeMin, v.sizeMean, v.sizeMax, sizeDelta, v.p50Ns, v.p99Ns, timeDelta);
+
+            csv.append(String.format(Locale.ROOT, "%s,%d,%d,%.1f,%d,%s,%.1f,%.1f,%s%n",
+                name, builds, v.sizeMin, v.sizeMean, v.sizeMax,
+                sizeDelta.replace("%", ""), v.p50Ns, v.p99Ns, timeDelta.replace("%", "")));
+        }
+
+        Files.writeString(out, csv.toString());
+        System.out.println("wrote " + out);
+    }
+}
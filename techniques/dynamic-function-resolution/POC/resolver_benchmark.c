@@ -0,0 +1,174 @@
+/*
+ * Resolver Strategy Benchmark
+ *
+ * Compares the two export lookup paths of ror13_resolver.c on real
+ * modules, so each module can be assigned a resolver style:
+ *
+ *   hash    - find_function_by_hash (linear walk, one hash per name)
+ *   bsearch - find_function_by_name (binary search over sorted names)
+ *
+ * Every named export of each module is looked up once per round; the
+ * reported figure is the best round's average cost per lookup. The two
+ * strategies swap order every round, so neither always runs on caches
+ * the other warmed. The hash path is run once per hash policy (ror13,
+ * wfnv), followed by each policy's hash_policy_check over every loaded
+ * module.
+ *
+ * Compile (host tool, not PIC):
+ *   x86_64-w64-mingw32-gcc -O2 resolver_benchmark.c -o resolver_benchmark.exe
+ */
+
+#define RESOLVER_NO_EXAMPLES
+#include "ror13_resolver.c"
+
+#include <stdio.h>
+
+#define BENCH_ROUNDS 5
+
+typedef struct {
+    const char* name;
+    DWORD exports;
+    DWORD mismatches;           // Hash collisions resolved to another export
+    double hash_ns;
+    double bsearch_ns;
+} STRATEGY_RESULT;
+
+static double elapsed_ns(LARGE_INTEGER start, LARGE_INTEGER end, LARGE_INTEGER freq) {
+    return (double)(end.QuadPart - start.QuadPart) * 1e9 / (double)freq.QuadPart;
+}
+
+static double time_hash(HMODULE hModule, const DWORD* hashes, DWORD count, LARGE_INTEGER freq) {
+    LARGE_INTEGER start, end;
+    volatile FARPROC sink;
+
+    QueryPerformanceCounter(&start);
+    for (DWORD i = 0; i < count; i++) {
+        sink = find_function_by_hash(hModule, hashes[i]);
+    }
+    QueryPerformanceCounter(&end);
+
+    (void)sink;
+    return elapsed_ns(start, end, freq) / count;
+}
+
+static double time_bsearch(HMODULE hModule, const DWORD* pNames, DWORD count, LARGE_INTEGER freq) {
+    LARGE_INTEGER start, end;
+    volatile FARPROC sink;
+
+    QueryPerformanceCounter(&start);
+    for (DWORD i = 0; i < count; i++) {
+        sink = find_function_by_name(hModule, (char*)((BYTE*)hModule + pNames[i]));
+    }
+    QueryPerformanceCounter(&end);
+
+    (void)sink;
+    return elapsed_ns(start, end, freq) / count;
+}
+
+static void bench_module(HMODULE hModule, STRATEGY_RESULT* result) {
+    PE_VIEW view;
+    if (!pe_view_get(&view, hModule) || !view.exports) return;
+
+    DWORD* pNames = view.names;
+    DWORD count = view.exports->NumberOfNames;
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+
+    // Hashes are what dfr bakes in at build time, so keep them out of the timing
+    DWORD* hashes = (DWORD*)VirtualAlloc(NULL, count * sizeof(DWORD),
+                                         MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!hashes) return;
+
+    for (DWORD i = 0; i < count; i++) {
+        hashes[i] = g_hash_policy->name_hash((char*)((BYTE*)hModule + pNames[i]));
+    }
+
+    result->exports = count;
+    result->mismatches = 0;
+    result->hash_ns = 0;
+    result->bsearch_ns = 0;
+
+    for (DWORD i = 0; i < count; i++) {
+        const char* name = (char*)((BYTE*)hModule + pNames[i]);
+        if (find_function_by_hash(hModule, hashes[i]) != find_function_by_name(hModule, name)) {
+            result->mismatches++;
+        }
+    }
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        double hash_ns, bsearch_ns;
+
+        // Alternate which strategy goes first
+        if (round & 1) {
+            bsearch_ns = time_bsearch(hModule, pNames, count, freq);
+            hash_ns = time_hash(hModule, hashes, count, freq);
+        } else {
+            hash_ns = time_hash(hModule, hashes, count, freq);
+            bsearch_ns = time_bsearch(hModule, pNames, count, freq);
+        }
+
+        if (round == 0 || hash_ns < result->hash_ns) result->hash_ns = hash_ns;
+        if (round == 0 || bsearch_ns < result->bsearch_ns) result->bsearch_ns = bsearch_ns;
+    }
+
+    VirtualFree(hashes, 0, MEM_RELEASE);
+}
+
+int main(void) {
+    const char* modules[] = {
+        "ntdll.dll",
+        "kernel32.dll",
+        "user32.dll",
+        NULL
+    };
+
+    const HASH_POLICY* policies[] = { &g_hash_ror13, &g_hash_wfnv, NULL };
+
+    for (int p = 0; policies[p]; p++) {
+        resolver_set_hash_policy(policies[p]);
+
+        printf("[%s]\n", policies[p]->name);
+        printf("%-14s %8s %13s %13s %8s %6s\n",
+               "module", "exports", "hash ns/op", "bsearch ns/op", "speedup", "coll");
+
+        for (int i = 0; modules[i]; i++) {
+            STRATEGY_RESULT result = {0};
+            result.name = modules[i];
+
+            HMODULE hModule = LoadLibraryA(modules[i]);
+            if (!hModule) {
+                printf("%-14s not loaded\n", modules[i]);
+                continue;
+            }
+
+            bench_module(hModule, &result);
+
+            printf("%-14s %8lu %13.1f %13.1f %7.1fx %6lu\n",
+                   result.name,
+                   result.exports,
+                   result.hash_ns,
+                   result.bsearch_ns,
+                   result.bsearch_ns > 0 ? result.hash_ns / result.bsearch_ns : 0.0,
+                   result.mismatches);
+        }
+
+        printf("\n");
+    }
+
+    // Collisions across everything loaded, per policy
+    static BYTE scratch[64 * 1024];
+
+    printf("%-8s %8s %8s %12s %12s %8s\n",
+           "policy", "modules", "exports", "export coll", "module coll", "skipped");
+
+    for (int p = 0; policies[p]; p++) {
+        HASH_CHECK_RESULT check;
+        hash_policy_check(policies[p], scratch, sizeof(scratch), &check);
+
+        printf("%-8s %8lu %8lu %12lu %12lu %8lu\n",
+               policies[p]->name, check.modules, check.exports,
+               check.export_collisions, check.module_collisions, check.skipped);
+    }
+
+    return 0;
+}
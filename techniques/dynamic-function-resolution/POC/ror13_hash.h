@@ -0,0 +1,62 @@
+/*
+ * Compile-Time ROR13 Hashes
+ *
+ * Derives the HASH_* constants from their names instead of pasting them
+ * by hand:
+ *
+ *   #define HASH_VIRTUALALLOC  ROR13("VirtualAlloc")
+ *   #define HASH_KERNEL32      ROR13_MODULE("kernel32.dll")
+ *
+ * ROR13() matches ror13_hash() and ROR13_MODULE() matches
+ * unicode_ror13_hash() (one step per character, a-z uppercased), so the
+ * results compare directly against the runtime walks.
+ *
+ * Each step uses the running hash exactly once, so the expansion grows
+ * linearly with ROR13_MAX_LENGTH. GCC folds the result to an immediate at
+ * -O1 and above, and always inside static initializers. It is not an
+ * integer constant expression, so it cannot be used for case labels or
+ * enumerators.
+ */
+
+#ifndef ROR13_HASH_H
+#define ROR13_HASH_H
+
+// Longest name accepted (longer literals fail to compile)
+#define ROR13_MAX_LENGTH 64
+
+// Character i of literal s, or 0 past the terminator
+#define ROR13_CHAR(s, i) \
+    ((i) < sizeof(s) - 1 ? (DWORD)(unsigned char)(s)[(i) < sizeof(s) ? (i) : 0] : 0)
+
+#define ROR13_UPPER(s, i) \
+    (ROR13_CHAR(s, i) - ((ROR13_CHAR(s, i) >= 'a' && ROR13_CHAR(s, i) <= 'z') ? 0x20 : 0))
+
+// Multiplying the 32-bit hash by 0x100000001 duplicates it into the high
+// half, so a 64-bit shift by 13 is a 32-bit rotate that uses h only once.
+// Past the end of the string the shift is 0 and the step is a no-op.
+#define ROR13_STEP(h, c, s, i) \
+    ((DWORD)(((((unsigned long long)(h) & 0xFFFFFFFFULL) * 0x100000001ULL >> \
+               ((i) < sizeof(s) - 1 ? 13 : 0)) + (c)) & 0xFFFFFFFFULL))
+
+#define ROR13_S(s, i, h)     ROR13_STEP(h, ROR13_CHAR(s, i), s, i)
+#define ROR13_SU(s, i, h)    ROR13_STEP(h, ROR13_UPPER(s, i), s, i)
+
+#define ROR13_4(S, s, i, h) \
+    S(s, (i) + 3, S(s, (i) + 2, S(s, (i) + 1, S(s, i, h))))
+#define ROR13_16(S, s, i, h) \
+    ROR13_4(S, s, (i) + 12, ROR13_4(S, s, (i) + 8, \
+    ROR13_4(S, s, (i) + 4, ROR13_4(S, s, i, h))))
+#define ROR13_64(S, s) \
+    ROR13_16(S, s, 48, ROR13_16(S, s, 32, \
+    ROR13_16(S, s, 16, ROR13_16(S, s, 0, 0))))
+
+#define ROR13_CHECK_LENGTH(s) \
+    (0 * sizeof(char[sizeof(s) <= ROR13_MAX_LENGTH + 1 ? 1 : -1]))
+
+// Function names (ror13_hash)
+#define ROR13(s)         ((DWORD)(ROR13_64(ROR13_S, s) + ROR13_CHECK_LENGTH(s)))
+
+// Module names (unicode_ror13_hash over BaseDllName)
+#define ROR13_MODULE(s)  ((DWORD)(ROR13_64(ROR13_SU, s) + ROR13_CHECK_LENGTH(s)))
+
+#endif // ROR13_HASH_H
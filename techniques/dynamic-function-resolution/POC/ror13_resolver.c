@@ -6,12 +6,32 @@
  *
  * Features:
  * - Walk PEB to find modules
- * - Hash-based module lookup
+ * - Hash-based module lookup (cached, refreshed on loader list changes)
  * - Hash-based function lookup
- * - Caching for performance
+ * - Per-module export index (O(1) lookups after first touch)
+ * - Batch resolution (one export scan per module)
+ * - Lazy binding stubs (resolve on first call, x64)
+ * - Binary search over sorted export names (string resolver)
+ * - Forwarded export and ordinal resolution (no GetProcAddress fallback)
+ * - Caching for performance (lock-free lookups, safe across threads)
+ * - Per-module invalidation on unload (DLL notifications)
+ * - Pluggable hash policy: ror13 (default, dfr compatible) or word FNV
+ * - Hash collision check across every loaded module's exports
+ * - Compile-time HASH_* constants (ror13_hash.h, wfnv_hash.h)
  */
 
 #include <windows.h>
+#include "ror13_hash.h"
+#include "wfnv_hash.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define PE_VIEW_CACHE_SIZE 64
+#include "../../position-independent-code/POC/pe_view.h"
 
 // ============================================================================
 // ROR13 HASHING
@@ -27,13 +47,12 @@ DWORD ror13_hash(const char* str) {
     return hash;
 }
 
-// Unicode version for module names
-DWORD unicode_ror13_hash(PUNICODE_STRING str) {
+// Module names: uppercased a-z, one step per WCHAR
+DWORD ror13_module_hash(const WCHAR* name, DWORD length) {
     DWORD hash = 0;
-    WCHAR* ptr = str->Buffer;
 
-    for (int i = 0; i < str->Length / sizeof(WCHAR); i++) {
-        WCHAR c = ptr[i];
+    for (DWORD i = 0; i < length; i++) {
+        WCHAR c = name[i];
 
         // Convert to uppercase
         if (c >= 'a' && c <= 'z') {
@@ -47,18 +66,208 @@ DWORD unicode_ror13_hash(PUNICODE_STRING str) {
     return hash;
 }
 
+// Unicode version for module names
+DWORD unicode_ror13_hash(PUNICODE_STRING str) {
+    return ror13_module_hash(str->Buffer, str->Length / sizeof(WCHAR));
+}
+
+// ============================================================================
+// WORD FNV HASHING
+// ============================================================================
+
+// FNV-1a over 8-byte words (wfnv_hash.h): one xor and one multiply per 8
+// characters instead of a rotate+add per character, and a 64-bit state
+// folded to 32 bits at the end, so names that differ only in their last
+// characters do not pile up in the low bits the way ror13's do.
+
+typedef unsigned long long __attribute__((may_alias, aligned(1))) WFNV_UNALIGNED;
+
+#define WFNV_ONES  0x0101010101010101ULL
+#define WFNV_HIGHS 0x8080808080808080ULL
+
+DWORD wfnv_hash(const char* str) {
+    unsigned long long hash = WFNV_OFFSET;
+    DWORD length = 0;
+
+    for (;;) {
+        unsigned long long word = 0;
+        DWORD bytes = 0;
+
+        if (((ULONG_PTR)str & 0xFFF) <= 0xFF8) {
+            // Whole word in this page: read it, then cut at the terminator
+            word = *(const WFNV_UNALIGNED*)str;
+            unsigned long long zero = (word - WFNV_ONES) & ~word & WFNV_HIGHS;
+
+            if (zero) {
+                bytes = (DWORD)__builtin_ctzll(zero) / 8;
+                word &= bytes ? ~0ULL >> (64 - bytes * 8) : 0;
+            } else {
+                bytes = 8;
+            }
+        } else {
+            // Near the end of a page: gather bytes, never read past the NUL
+            while (bytes < 8 && str[bytes]) {
+                word |= (unsigned long long)(BYTE)str[bytes] << (bytes * 8);
+                bytes++;
+            }
+        }
+
+        if (bytes) {
+            hash = (hash ^ word) * WFNV_PRIME;
+            length += bytes;
+        }
+
+        if (bytes < 8) break;
+        str += 8;
+    }
+
+    return WFNV_FINISH(hash, length);
+}
+
+// Module names: uppercased a-z, low byte of each WCHAR
+DWORD wfnv_module_hash(const WCHAR* name, DWORD length) {
+    unsigned long long hash = WFNV_OFFSET;
+
+    for (DWORD i = 0; i < length; i += 8) {
+        unsigned long long word = 0;
+
+        for (DWORD k = 0; k < 8 && i + k < length; k++) {
+            WCHAR c = name[i + k];
+            if (c >= 'a' && c <= 'z') c -= 0x20;
+            word |= (unsigned long long)(BYTE)c << (k * 8);
+        }
+
+        hash = (hash ^ word) * WFNV_PRIME;
+    }
+
+    return WFNV_FINISH(hash, length);
+}
+
+// ============================================================================
+// HASH POLICY
+// ============================================================================
+
+// Every lookup below hashes through g_hash_policy, so switching the
+// policy switches module, export, index and cache keys together. HASH_*
+// constants must come from the matching macros: RESOLVER_HASH() and
+// RESOLVER_MODULE_HASH() follow the compile-time default, ror13 unless
+// built with -DRESOLVER_HASH_WFNV.
+//
+// Crystal Palace computes the hashes for dfr "resolve" "ror13" itself, so
+// a dfr resolver must stay on ror13; wfnv is for hand-written call sites.
+
+typedef struct {
+    const char* name;
+    DWORD (*name_hash)(const char* name);
+    DWORD (*module_hash)(const WCHAR* name, DWORD length);
+} HASH_POLICY;
+
+const HASH_POLICY g_hash_ror13 = { "ror13", ror13_hash, ror13_module_hash };
+const HASH_POLICY g_hash_wfnv = { "wfnv", wfnv_hash, wfnv_module_hash };
+
+#ifdef RESOLVER_HASH_WFNV
+#define RESOLVER_HASH(s)        WFNV(s)
+#define RESOLVER_MODULE_HASH(s) WFNV_MODULE(s)
+const HASH_POLICY* g_hash_policy = &g_hash_wfnv;
+#else
+#define RESOLVER_HASH(s)        ROR13(s)
+#define RESOLVER_MODULE_HASH(s) ROR13_MODULE(s)
+const HASH_POLICY* g_hash_policy = &g_hash_ror13;
+#endif
+
+static DWORD module_name_hash(PUNICODE_STRING name) {
+    return g_hash_policy->module_hash(name->Buffer, name->Length / sizeof(WCHAR));
+}
+
+#define MAX_MODULE_NAME 128
+
+// Module hash from an ASCII name such as "KERNEL32", "kernel32.dll" or a
+// forwarder prefix. Matches the policy's hash over the BaseDllName;
+// ".DLL" is implied when the name has no extension.
+DWORD ascii_module_hash(const char* name, DWORD length) {
+    WCHAR wide[MAX_MODULE_NAME + 4];
+    DWORD n = 0;
+    BOOL has_extension = FALSE;
+
+    for (DWORD i = 0; i < length && name[i] && n < MAX_MODULE_NAME; i++) {
+        if (name[i] == '.') has_extension = TRUE;
+        wide[n++] = (WCHAR)(BYTE)name[i];
+    }
+
+    if (!has_extension) {
+        const char* ext = ".DLL";
+        for (int i = 0; ext[i]; i++) {
+            wide[n++] = (WCHAR)ext[i];
+        }
+    }
+
+    return g_hash_policy->module_hash(wide, n);
+}
+
 // ============================================================================
 // MODULE LOOKUP
 // ============================================================================
 
-HMODULE find_module_by_hash(DWORD module_hash) {
+PPEB_LDR_DATA get_loader_data(void) {
     #ifdef _WIN64
     PPEB pPeb = (PPEB)__readgsqword(0x60);
     #else
     PPEB pPeb = (PPEB)__readfsdword(0x30);
     #endif
 
-    PPEB_LDR_DATA pLdr = pPeb->Ldr;
+    return pPeb->Ldr;
+}
+
+// Images whose unload notification arrived while they may still be
+// linked into the loader list (see MODULE UNLOAD TRACKING). The walks
+// skip them; module_cache_refresh forgets any it no longer finds in the
+// list, and a load at the same base clears it. A set, because unloading
+// a DLL unloads its dependents with it. Guarded by g_resolve_lock.
+#define MAX_UNLOADING_BASES 16
+
+PVOID g_unloading_bases[MAX_UNLOADING_BASES];
+DWORD g_unloading_count = 0;
+
+static int unloading_index(PVOID base) {
+    for (DWORD i = 0; i < g_unloading_count; i++) {
+        if (g_unloading_bases[i] == base) return (int)i;
+    }
+    return -1;
+}
+
+// Full: the oldest entry goes (it is the most likely to be unlinked)
+static void unloading_add(PVOID base) {
+    if (unloading_index(base) >= 0) return;
+
+    if (g_unloading_count == MAX_UNLOADING_BASES) {
+        for (DWORD i = 1; i < MAX_UNLOADING_BASES; i++) {
+            g_unloading_bases[i - 1] = g_unloading_bases[i];
+        }
+        g_unloading_count--;
+    }
+
+    g_unloading_bases[g_unloading_count++] = base;
+}
+
+static void unloading_remove(PVOID base) {
+    int i = unloading_index(base);
+    if (i >= 0) {
+        g_unloading_bases[i] = g_unloading_bases[--g_unloading_count];
+    }
+}
+
+// Keep only the bases whose bit is set in seen (still linked)
+static void unloading_keep(DWORD seen) {
+    DWORD kept = 0;
+    for (DWORD i = 0; i < g_unloading_count; i++) {
+        if (seen & (1u << i)) g_unloading_bases[kept++] = g_unloading_bases[i];
+    }
+    g_unloading_count = kept;
+}
+
+// Full walk, hashing every BaseDllName
+HMODULE find_module_by_hash_uncached(DWORD module_hash) {
+    PPEB_LDR_DATA pLdr = get_loader_data();
     PLIST_ENTRY pListHead = &pLdr->InMemoryOrderModuleList;
     PLIST_ENTRY pListEntry = pListHead->Flink;
 
@@ -69,9 +278,9 @@ HMODULE find_module_by_hash(DWORD module_hash) {
             InMemoryOrderLinks
         );
 
-        DWORD hash = unicode_ror13_hash(&pEntry->BaseDllName);
+        DWORD hash = module_name_hash(&pEntry->BaseDllName);
 
-        if (hash == module_hash) {
+        if (hash == module_hash && unloading_index(pEntry->DllBase) < 0) {
             return (HMODULE)pEntry->DllBase;
         }
 
@@ -81,121 +290,1226 @@ HMODULE find_module_by_hash(DWORD module_hash) {
     return NULL;
 }
 
+// ============================================================================
+// MODULE CACHE
+// ============================================================================
+
+// (hash -> DllBase) for every loaded module, filled in a single walk. The
+// snapshot of the list head links and entry count tells us when the
+// loader list changed: the head links are checked on every lookup, and
+// the count is re-walked (pointers only, no hashing) on a miss. Unloads in
+// the middle of the list change neither; resolver_module_unloaded() (see
+// MODULE UNLOAD TRACKING) drops just that module instead.
+
+#define MAX_CACHED_MODULES 64
+
+typedef struct {
+    DWORD hash;
+    HMODULE base;
+} MODULE_CACHE_ENTRY;
+
+typedef struct {
+    PLIST_ENTRY head_flink;
+    PLIST_ENTRY head_blink;
+    DWORD list_count;           // Entries in the loader list at snapshot
+    DWORD count;                // Entries cached (<= MAX_CACHED_MODULES)
+    BOOL valid;
+    MODULE_CACHE_ENTRY entries[MAX_CACHED_MODULES];
+} MODULE_CACHE;
+
+MODULE_CACHE g_module_cache = {0};
+
+static DWORD loader_list_count(PLIST_ENTRY pListHead) {
+    DWORD count = 0;
+    for (PLIST_ENTRY p = pListHead->Flink; p != pListHead; p = p->Flink) {
+        count++;
+    }
+    return count;
+}
+
+void module_cache_refresh(void) {
+    PPEB_LDR_DATA pLdr = get_loader_data();
+    PLIST_ENTRY pListHead = &pLdr->InMemoryOrderModuleList;
+    PLIST_ENTRY pListEntry = pListHead->Flink;
+    MODULE_CACHE* cache = &g_module_cache;
+
+    DWORD seen = 0;             // Pending unloads still in the list
+
+    cache->count = 0;
+    cache->list_count = 0;
+
+    while (pListEntry != pListHead) {
+        PLDR_DATA_TABLE_ENTRY pEntry = CONTAINING_RECORD(
+            pListEntry,
+            LDR_DATA_TABLE_ENTRY,
+            InMemoryOrderLinks
+        );
+
+        int pending = unloading_index(pEntry->DllBase);
+
+        if (pending >= 0) {
+            seen |= 1u << pending;
+        } else if (cache->count < MAX_CACHED_MODULES) {
+            cache->entries[cache->count].hash = module_name_hash(&pEntry->BaseDllName);
+            cache->entries[cache->count].base = (HMODULE)pEntry->DllBase;
+            cache->count++;
+        }
+
+        cache->list_count++;
+        pListEntry = pListEntry->Flink;
+    }
+
+    // Unloads that are no longer linked are finished
+    unloading_keep(seen);
+
+    cache->head_flink = pListHead->Flink;
+    cache->head_blink = pListHead->Blink;
+    cache->valid = TRUE;
+}
+
+void module_cache_invalidate(void) {
+    g_module_cache.valid = FALSE;
+    pe_view_cache_reset();
+}
+
+// Forget one module. list_count is left alone, so the next miss sees the
+// shorter loader list and re-walks it.
+void module_cache_drop(HMODULE hModule) {
+    MODULE_CACHE* cache = &g_module_cache;
+
+    for (DWORD i = 0; i < cache->count; i++) {
+        if (cache->entries[i].base == hModule) {
+            cache->entries[i] = cache->entries[--cache->count];
+            break;
+        }
+    }
+
+    pe_view_cache_drop(hModule);
+}
+
+static HMODULE module_cache_find(DWORD module_hash) {
+    for (DWORD i = 0; i < g_module_cache.count; i++) {
+        if (g_module_cache.entries[i].hash == module_hash) {
+            return g_module_cache.entries[i].base;
+        }
+    }
+    return NULL;
+}
+
+HMODULE find_module_by_hash(DWORD module_hash) {
+    PLIST_ENTRY pListHead = &get_loader_data()->InMemoryOrderModuleList;
+    MODULE_CACHE* cache = &g_module_cache;
+
+    if (!cache->valid ||
+        pListHead->Flink != cache->head_flink ||
+        pListHead->Blink != cache->head_blink) {
+        module_cache_refresh();
+    }
+
+    HMODULE hModule = module_cache_find(module_hash);
+    if (hModule) return hModule;
+
+    // Miss: refresh only if modules were added/removed mid-list
+    if (loader_list_count(pListHead) != cache->list_count) {
+        module_cache_refresh();
+        hModule = module_cache_find(module_hash);
+        if (hModule) return hModule;
+    }
+
+    // More modules than the cache holds: walk the rest
+    if (cache->list_count > cache->count) {
+        return find_module_by_hash_uncached(module_hash);
+    }
+
+    return NULL;
+}
+
 // ============================================================================
 // FUNCTION LOOKUP
 // ============================================================================
 
+// RVA of the i-th named export (0 if its ordinal is out of range)
+static DWORD export_name_rva(const PE_VIEW* view, DWORD i) {
+    WORD ordinal = view->ordinals[i];
+    return ordinal < view->exports->NumberOfFunctions ? view->functions[ordinal] : 0;
+}
+
+// Turns an export RVA into an address, chasing forwarders (see below)
+static FARPROC export_target(const PE_VIEW* view, DWORD rva, DWORD depth);
+
 FARPROC find_function_by_hash(HMODULE hModule, DWORD function_hash) {
+    PE_VIEW view;
+    if (!pe_view_get(&view, hModule) || !view.exports) return NULL;
+
+    for (DWORD i = 0; i < view.exports->NumberOfNames; i++) {
+        char* funcName = (char*)(view.base + view.names[i]);
+        DWORD hash = g_hash_policy->name_hash(funcName);
+
+        if (hash == function_hash) {
+            return export_target(&view, export_name_rva(&view, i), 0);
+        }
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// EXPORT INDEX
+// ============================================================================
+
+// Per-module open-addressed table of (name hash -> function RVA), built on
+// the first lookup against a module. Slot storage is carved from a
+// caller-supplied arena; a module that does not fit falls back to the
+// linear walk in find_function_by_hash.
+
+#define MAX_INDEXED_MODULES 16
+
+typedef struct {
+    DWORD hash;
+    DWORD rva;                  // 0 = empty slot (no export lives at RVA 0)
+} EXPORT_SLOT;
+
+typedef struct {
+    HMODULE module;
+    PE_VIEW view;               // Kept for forwarder checks on lookup
+    EXPORT_SLOT* slots;
+    DWORD mask;                 // capacity - 1, capacity is a power of two
+} EXPORT_INDEX;
+
+typedef struct {
+    BYTE* base;
+    SIZE_T size;
+    SIZE_T used;
+    DWORD count;
+    EXPORT_INDEX modules[MAX_INDEXED_MODULES];
+} EXPORT_INDEX_ARENA;
+
+void export_index_arena_init(EXPORT_INDEX_ARENA* arena, void* memory, SIZE_T size) {
+    arena->base = (BYTE*)memory;
+    arena->size = size;
+    arena->used = 0;
+    arena->count = 0;
+}
+
+// ror13 keeps the last characters in the low bits, so mix before masking
+// (harmless for wfnv)
+static DWORD export_slot_of(DWORD hash, DWORD mask) {
+    hash ^= hash >> 16;
+    hash *= 0x45D9F3B;
+    hash ^= hash >> 16;
+    return hash & mask;
+}
+
+EXPORT_INDEX* export_index_build(EXPORT_INDEX_ARENA* arena, HMODULE hModule) {
+    PE_VIEW view;
+    if (!pe_view_get(&view, hModule) || !view.exports) return NULL;
+
+    if (arena->count >= MAX_INDEXED_MODULES) return NULL;
+
+    // Keep the load factor at or below ~2/3
+    DWORD count = view.exports->NumberOfNames;
+    DWORD capacity = 16;
+    while (capacity < count + count / 2) {
+        capacity <<= 1;
+    }
+
+    SIZE_T offset = (arena->used + 7) & ~(SIZE_T)7;
+    SIZE_T bytes = capacity * sizeof(EXPORT_SLOT);
+    if (offset + bytes > arena->size) return NULL;
+
+    EXPORT_SLOT* slots = (EXPORT_SLOT*)(arena->base + offset);
+    for (DWORD i = 0; i < capacity; i++) {
+        slots[i].hash = 0;
+        slots[i].rva = 0;
+    }
+
+    DWORD mask = capacity - 1;
+
+    for (DWORD i = 0; i < count; i++) {
+        DWORD hash = g_hash_policy->name_hash((char*)(view.base + view.names[i]));
+        DWORD rva = export_name_rva(&view, i);
+        if (!rva) continue;
+
+        DWORD slot = export_slot_of(hash, mask);
+        while (slots[slot].rva && slots[slot].hash != hash) {
+            slot = (slot + 1) & mask;
+        }
+
+        // On a hash collision the first name wins, same as the linear walk
+        if (!slots[slot].rva) {
+            slots[slot].hash = hash;
+            slots[slot].rva = rva;
+        }
+    }
+
+    arena->used = offset + bytes;
+
+    EXPORT_INDEX* index = &arena->modules[arena->count++];
+    index->module = hModule;
+    index->view = view;
+    index->slots = slots;
+    index->mask = mask;
+    return index;
+}
+
+FARPROC export_index_lookup(EXPORT_INDEX* index, DWORD function_hash) {
+    DWORD slot = export_slot_of(function_hash, index->mask);
+
+    while (index->slots[slot].rva) {
+        if (index->slots[slot].hash == function_hash) {
+            return export_target(&index->view, index->slots[slot].rva, 0);
+        }
+        slot = (slot + 1) & index->mask;
+    }
+
+    return NULL;
+}
+
+// Unload: the module's slots stay carved out of the arena until it is
+// reset, but its index entry is free for another module
+void export_index_drop(EXPORT_INDEX_ARENA* arena, HMODULE hModule) {
+    for (DWORD i = 0; i < arena->count; i++) {
+        if (arena->modules[i].module == hModule) {
+            arena->modules[i] = arena->modules[--arena->count];
+            return;
+        }
+    }
+}
+
+FARPROC find_function_indexed(EXPORT_INDEX_ARENA* arena, HMODULE hModule, DWORD function_hash) {
     if (!hModule) return NULL;
 
-    PIMAGE_DOS_HEADER pDosHeader = (PIMAGE_DOS_HEADER)hModule;
-    if (pDosHeader->e_magic != IMAGE_DOS_SIGNATURE) {
-        return NULL;
+    EXPORT_INDEX* index = NULL;
+    for (DWORD i = 0; i < arena->count; i++) {
+        if (arena->modules[i].module == hModule) {
+            index = &arena->modules[i];
+            break;
+        }
     }
 
-    PIMAGE_NT_HEADERS pNtHeaders = (PIMAGE_NT_HEADERS)(
-        (BYTE*)hModule + pDosHeader->e_lfanew
-    );
+    // First touch: build the index for this module
+    if (!index) {
+        index = export_index_build(arena, hModule);
+    }
 
-    if (pNtHeaders->Signature != IMAGE_NT_SIGNATURE) {
-        return NULL;
+    if (!index) {
+        return find_function_by_hash(hModule, function_hash);
     }
 
-    DWORD export_rva = pNtHeaders->OptionalHeader.DataDirectory[
-        IMAGE_DIRECTORY_ENTRY_EXPORT
-    ].VirtualAddress;
+    return export_index_lookup(index, function_hash);
+}
 
-    if (!export_rva) return NULL;
+// ============================================================================
+// SORTED NAME LOOKUP
+// ============================================================================
 
-    PIMAGE_EXPORT_DIRECTORY pExportDir = (PIMAGE_EXPORT_DIRECTORY)(
-        (BYTE*)hModule + export_rva
-    );
+// AddressOfNames is sorted lexically (the loader relies on this too), so a
+// string-keyed lookup is O(log n) compares instead of O(n) hashes. Suits
+// the dfr "resolve_ext" "strings" resolver style.
 
-    DWORD* pNames = (DWORD*)((BYTE*)hModule + pExportDir->AddressOfNames);
-    DWORD* pFunctions = (DWORD*)((BYTE*)hModule + pExportDir->AddressOfFunctions);
-    WORD* pOrdinals = (WORD*)((BYTE*)hModule + pExportDir->AddressOfNameOrdinals);
+static int export_name_compare(const char* a, const char* b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return (int)(BYTE)*a - (int)(BYTE)*b;
+}
 
-    for (DWORD i = 0; i < pExportDir->NumberOfNames; i++) {
-        char* funcName = (char*)((BYTE*)hModule + pNames[i]);
-        DWORD hash = ror13_hash(funcName);
+static FARPROC find_export_by_name(HMODULE hModule, const char* function_name, DWORD depth) {
+    PE_VIEW view;
+    if (!pe_view_get(&view, hModule) || !view.exports) return NULL;
 
-        if (hash == function_hash) {
-            DWORD func_rva = pFunctions[pOrdinals[i]];
-            return (FARPROC)((BYTE*)hModule + func_rva);
+    DWORD lo = 0;
+    DWORD hi = view.exports->NumberOfNames;
+
+    while (lo < hi) {
+        DWORD mid = lo + (hi - lo) / 2;
+        int cmp = export_name_compare(
+            function_name, (char*)(view.base + view.names[mid])
+        );
+
+        if (cmp == 0) {
+            return export_target(&view, export_name_rva(&view, mid), depth);
         }
+
+        if (cmp < 0) hi = mid;
+        else lo = mid + 1;
     }
 
     return NULL;
 }
 
+FARPROC find_function_by_name(HMODULE hModule, const char* function_name) {
+    return find_export_by_name(hModule, function_name, 0);
+}
+
+// ============================================================================
+// ORDINALS AND FORWARDERS
+// ============================================================================
+
+// An export whose RVA lands inside the export directory is a forwarder
+// string, "MODULE.Function" or "MODULE.#ordinal" (e.g. kernel32's
+// HeapAlloc -> "NTDLL.RtlAllocateHeap"). These are chased through the
+// module cache rather than handed back as code pointers. API set targets
+// ("api-ms-win-...") are not loader list names and resolve to NULL.
+
+#define MAX_FORWARD_DEPTH 4
+
+static FARPROC find_export_by_ordinal(HMODULE hModule, DWORD ordinal, DWORD depth) {
+    PE_VIEW view;
+    if (!pe_view_get(&view, hModule) || !view.exports) return NULL;
+
+    DWORD index = ordinal - view.exports->Base;
+    if (ordinal < view.exports->Base || index >= view.exports->NumberOfFunctions) {
+        return NULL;
+    }
+
+    return export_target(&view, view.functions[index], depth);
+}
+
+FARPROC find_function_by_ordinal(HMODULE hModule, WORD ordinal) {
+    return find_export_by_ordinal(hModule, ordinal, 0);
+}
+
+static FARPROC resolve_forwarder(const char* forwarder, DWORD depth) {
+    if (depth >= MAX_FORWARD_DEPTH) return NULL;
+
+    // Module part ends at the last '.'
+    const char* dot = NULL;
+    for (const char* p = forwarder; *p; p++) {
+        if (*p == '.') dot = p;
+    }
+    if (!dot) return NULL;
+
+    HMODULE hTarget = find_module_by_hash(
+        ascii_module_hash(forwarder, (DWORD)(dot - forwarder))
+    );
+    if (!hTarget) return NULL;
+
+    const char* symbol = dot + 1;
+    if (*symbol == '#') {
+        DWORD ordinal = 0;
+        for (symbol++; *symbol >= '0' && *symbol <= '9'; symbol++) {
+            ordinal = ordinal * 10 + (DWORD)(*symbol - '0');
+        }
+        return find_export_by_ordinal(hTarget, ordinal, depth + 1);
+    }
+
+    return find_export_by_name(hTarget, symbol, depth + 1);
+}
+
+static FARPROC export_target(const PE_VIEW* view, DWORD rva, DWORD depth) {
+    if (!rva || !pe_view_contains(view, rva, 1)) return NULL;
+
+    if (pe_view_is_forwarder(view, rva)) {
+        return resolve_forwarder((char*)view->base + rva, depth);
+    }
+
+    return (FARPROC)(view->base + rva);
+}
+
 // ============================================================================
 // CACHED RESOLVER
 // ============================================================================
 
-#define MAX_CACHE_ENTRIES 256
+// Set-associative table keyed on (module_hash, function_hash), stored as
+// parallel arrays. The combined 64-bit keys of a bucket fill one 64-byte
+// line, and a lookup compares all of them at once (AVX2/SSE2, scalar
+// otherwise) before touching anything else; sequence, generation and
+// address are read only for the slot that matched. When a bucket is
+// full, insertion evicts one of its slots (round-robin), so the cache
+// keeps absorbing new entries instead of freezing once it fills up.
+//
+// Safe to call from several threads (thread-pool callbacks, etc.):
+//
+// - Each slot has a sequence word: 0 = empty, odd = being written, even =
+//   published. A writer claims a slot with a CAS to odd, fills it and
+//   publishes the next even value; slots are never emptied again.
+// - Readers take no lock: key compare, then sequence, entry, sequence
+//   again. A slot counts only when both reads saw the same even value (a
+//   writer that claimed it in between changes the sequence), so a key
+//   compared mid-write costs at most a miss.
+// - Misses take g_resolve_lock, because the module cache, PE view cache
+//   and export indexes behind them are single-threaded.
+// - Each entry records its module's generation when it was resolved. An
+//   unload bumps that generation (resolver_module_unloaded), so the
+//   module's entries stop matching while every other entry stays hot.
+//
+// x86/x64 only: stores are not reordered with stores nor loads with loads
+// there, so compiler barriers are enough between the plain accesses.
+//
+// hits/misses are plain increments (approximate under contention). Build
+// with -DRESOLVER_NO_CACHE_STATS to keep shared writes off the hit path.
+
+#define MAX_CACHE_ENTRIES 256       // Power of two
+#define CACHE_BUCKET_SIZE 8         // 8 keys = one cache line
+#define CACHE_BUCKETS     (MAX_CACHE_ENTRIES / CACHE_BUCKET_SIZE)
+
+#define CACHE_BARRIER() __asm__ __volatile__("" ::: "memory")
 
+// Generations are kept per slot of a small table keyed by module hash.
+// Modules that share a slot are invalidated together, which costs a
+// re-resolve but never returns a stale address.
+#define MODULE_GENERATION_SLOTS 64  // Power of two
+
+// Slot i of every array is one entry
 typedef struct {
-    DWORD module_hash;
-    DWORD function_hash;
-    FARPROC address;
-} CACHE_ENTRY;
+    ULONGLONG keys[MAX_CACHE_ENTRIES] __attribute__((aligned(64)));
+    volatile LONG sequence[MAX_CACHE_ENTRIES];  // 0 = empty, odd = busy, even = published
+    LONG generation[MAX_CACHE_ENTRIES];         // Module generation at resolve time
+    FARPROC address[MAX_CACHE_ENTRIES];
+} RESOLVE_CACHE;
+
+typedef struct {
+    DWORD hits;
+    DWORD misses;
+    DWORD evictions;
+    DWORD entries;
+} CACHE_STATS;
+
+#ifdef RESOLVER_NO_CACHE_STATS
+#define CACHE_STAT(field) ((void)0)
+#else
+#define CACHE_STAT(field) (g_cache_stats.field++)
+#endif
+
+RESOLVE_CACHE g_cache;
+CACHE_STATS g_cache_stats = {0};
+volatile LONG g_cache_victim = 0;
+volatile LONG g_resolve_lock = 0;
+volatile LONG g_module_generation[MODULE_GENERATION_SLOTS];
+
+// Optional export index used on cache misses (NULL = linear export walk)
+EXPORT_INDEX_ARENA* g_export_arena = NULL;
+
+void resolver_set_export_arena(EXPORT_INDEX_ARENA* arena) {
+    g_export_arena = arena;
+}
+
+// Miss path only: PEB walks and export scans are short, so spin
+static void resolve_lock(void) {
+    while (InterlockedCompareExchange(&g_resolve_lock, 1, 0) != 0) {
+        while (g_resolve_lock) YieldProcessor();
+    }
+}
+
+static void resolve_unlock(void) {
+    CACHE_BARRIER();
+    g_resolve_lock = 0;
+}
 
-CACHE_ENTRY g_cache[MAX_CACHE_ENTRIES];
-int g_cache_count = 0;
+static volatile LONG* module_generation(DWORD module_hash) {
+    DWORD h = module_hash * 0x9E3779B1;
+    return &g_module_generation[(h >> 16) & (MODULE_GENERATION_SLOTS - 1)];
+}
+
+static ULONGLONG cache_key(DWORD module_hash, DWORD function_hash) {
+    return ((ULONGLONG)module_hash << 32) | function_hash;
+}
+
+// First slot of the key's bucket
+static DWORD cache_bucket_of(ULONGLONG key) {
+    DWORD h = ((DWORD)(key >> 32) * 0x9E3779B1) ^ (DWORD)key;
+    h ^= h >> 16;
+    h *= 0x45D9F3B;
+    h ^= h >> 16;
+    return (h & (CACHE_BUCKETS - 1)) * CACHE_BUCKET_SIZE;
+}
+
+// Bit i set when keys[first + i] == key
+static DWORD cache_match(DWORD first, ULONGLONG key) {
+    const ULONGLONG* keys = &g_cache.keys[first];
+
+#if defined(__AVX2__)
+    __m256i k = _mm256_set1_epi64x((long long)key);
+    __m256i lo = _mm256_cmpeq_epi64(_mm256_load_si256((const __m256i*)keys), k);
+    __m256i hi = _mm256_cmpeq_epi64(_mm256_load_si256((const __m256i*)(keys + 4)), k);
+    return (DWORD)_mm256_movemask_pd(_mm256_castsi256_pd(lo)) |
+           ((DWORD)_mm256_movemask_pd(_mm256_castsi256_pd(hi)) << 4);
+#elif defined(__SSE2__)
+    // No 64-bit compare before SSE4.1: both 32-bit halves must match
+    __m128i k = _mm_set1_epi64x((long long)key);
+    DWORD mask = 0;
+    for (DWORD i = 0; i < CACHE_BUCKET_SIZE; i += 2) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(keys + i)), k);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        mask |= (DWORD)_mm_movemask_pd(_mm_castsi128_pd(eq)) << i;
+    }
+    return mask;
+#else
+    DWORD mask = 0;
+    for (DWORD i = 0; i < CACHE_BUCKET_SIZE; i++) {
+        if (keys[i] == key) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// Claim a slot whose sequence is still `seen`, fill it, publish
+static BOOL cache_write(DWORD slot, LONG seen, ULONGLONG key, LONG generation,
+                        FARPROC addr) {
+    if (InterlockedCompareExchange(&g_cache.sequence[slot], seen | 1, seen) != seen) {
+        return FALSE;
+    }
+
+    g_cache.keys[slot] = key;
+    g_cache.generation[slot] = generation;
+    g_cache.address[slot] = addr;
+    CACHE_BARRIER();
+
+    // Unsigned, so the wrap at 0xFFFFFFFF is defined; skip 0 there so a
+    // published slot never reads as empty
+    ULONG next = ((ULONG)seen | 1u) + 1u;
+    if (next == 0) next = 2;
+    g_cache.sequence[slot] = (LONG)next;
+    return TRUE;
+}
+
+// Published entry for the key and generation in this slot, or NULL
+static FARPROC cache_read(DWORD slot, LONG sequence, ULONGLONG key, LONG generation) {
+    CACHE_BARRIER();
+    ULONGLONG entry_key = g_cache.keys[slot];
+    LONG entry_generation = g_cache.generation[slot];
+    FARPROC addr = g_cache.address[slot];
+    CACHE_BARRIER();
+
+    if (g_cache.sequence[slot] != sequence) return NULL;
+    if (entry_key != key || entry_generation != generation) return NULL;
+    return addr;
+}
+
+// Lowest set bit (matches are rare, so at most one or two iterations)
+static DWORD cache_next_bit(DWORD* mask) {
+    DWORD bit = (DWORD)__builtin_ctz(*mask);
+    *mask &= *mask - 1;
+    return bit;
+}
+
+// generation must be read before the module was looked up, so a lookup
+// that races an unload is stored already stale
+static void cache_insert(DWORD module_hash, DWORD function_hash, LONG generation,
+                         FARPROC addr) {
+    ULONGLONG key = cache_key(module_hash, function_hash);
+    DWORD first = cache_bucket_of(key);
+
+    for (DWORD mask = cache_match(first, key); mask; ) {
+        DWORD slot = first + cache_next_bit(&mask);
+        LONG sequence = g_cache.sequence[slot];
+        if (!sequence || (sequence & 1)) continue;
+
+        // Another thread got there first
+        if (cache_read(slot, sequence, key, generation) == addr) return;
+
+        // Same key from before an unload (or a reload): reuse the slot
+        if (g_cache.keys[slot] == key) {
+            cache_write(slot, sequence, key, generation, addr);
+            return;
+        }
+    }
+
+    for (DWORD i = 0; i < CACHE_BUCKET_SIZE; i++) {
+        if (g_cache.sequence[first + i] == 0 &&
+            cache_write(first + i, 0, key, generation, addr)) {
+            InterlockedIncrement((volatile LONG*)&g_cache_stats.entries);
+            return;
+        }
+    }
+
+    // Bucket full: replace a published slot in place. Losing the race for
+    // the victim just leaves this entry uncached.
+    DWORD victim = first + ((DWORD)InterlockedIncrement(&g_cache_victim) % CACHE_BUCKET_SIZE);
+    LONG sequence = g_cache.sequence[victim];
+
+    if (sequence && !(sequence & 1) &&
+        cache_write(victim, sequence, key, generation, addr)) {
+        InterlockedIncrement((volatile LONG*)&g_cache_stats.evictions);
+    }
+}
+
+// Empties every slot; not safe while other threads are resolving
+void resolve_cache_reset(void) {
+    for (DWORD i = 0; i < MAX_CACHE_ENTRIES; i++) {
+        g_cache.sequence[i] = 0;
+        g_cache.keys[i] = 0;
+    }
+    g_cache_stats.entries = 0;
+    g_cache_victim = 0;
+}
 
 FARPROC resolve_cached(DWORD module_hash, DWORD function_hash) {
     // Check cache
-    for (int i = 0; i < g_cache_count; i++) {
-        if (g_cache[i].module_hash == module_hash &&
-            g_cache[i].function_hash == function_hash) {
-            return g_cache[i].address;
+    ULONGLONG key = cache_key(module_hash, function_hash);
+    DWORD first = cache_bucket_of(key);
+    LONG generation = *module_generation(module_hash);
+
+    // Busy slots are skipped; worst case is an extra miss
+    for (DWORD mask = cache_match(first, key); mask; ) {
+        DWORD slot = first + cache_next_bit(&mask);
+        LONG sequence = g_cache.sequence[slot];
+        if (!sequence || (sequence & 1)) continue;
+
+        FARPROC addr = cache_read(slot, sequence, key, generation);
+        if (addr) {
+            CACHE_STAT(hits);
+            return addr;
         }
     }
 
+    CACHE_STAT(misses);
+
     // Not in cache, resolve
+    resolve_lock();
+
+    generation = *module_generation(module_hash);
     HMODULE hModule = find_module_by_hash(module_hash);
-    FARPROC addr = find_function_by_hash(hModule, function_hash);
+    FARPROC addr = g_export_arena
+        ? find_function_indexed(g_export_arena, hModule, function_hash)
+        : find_function_by_hash(hModule, function_hash);
 
-    // Add to cache if space available
-    if (addr && g_cache_count < MAX_CACHE_ENTRIES) {
-        g_cache[g_cache_count].module_hash = module_hash;
-        g_cache[g_cache_count].function_hash = function_hash;
-        g_cache[g_cache_count].address = addr;
-        g_cache_count++;
+    resolve_unlock();
+
+    if (addr) {
+        cache_insert(module_hash, function_hash, generation, addr);
     }
 
     return addr;
 }
 
+void resolve_cache_stats(CACHE_STATS* stats) {
+    *stats = g_cache_stats;
+}
+
+// Switches every later lookup to another hash. Everything keyed on the
+// old one (module cache, export indexes, resolver cache) is dropped; the
+// index arena is reused from the start. Not safe while other threads
+// are resolving.
+void resolver_set_hash_policy(const HASH_POLICY* policy) {
+    if (!policy || policy == g_hash_policy) return;
+
+    g_hash_policy = policy;
+    module_cache_invalidate();
+    resolve_cache_reset();
+
+    if (g_export_arena) {
+        g_export_arena->used = 0;
+        g_export_arena->count = 0;
+    }
+}
+
+// ============================================================================
+// BATCH RESOLVER
+// ============================================================================
+
+// Resolves a whole import set (known up front with dfr "resolve" "ror13")
+// with one module cache lookup and one export scan per module: requests
+// are sorted by (module_hash, function_hash), then every export name is
+// hashed once and binary-searched against the pending hashes for its
+// module.
+
+typedef struct {
+    DWORD module_hash;
+    DWORD function_hash;
+    FARPROC* out;
+} RESOLVE_REQUEST;
+
+static int request_less(const RESOLVE_REQUEST* a, const RESOLVE_REQUEST* b) {
+    if (a->module_hash != b->module_hash) {
+        return a->module_hash < b->module_hash;
+    }
+    return a->function_hash < b->function_hash;
+}
+
+// Insertion sort: import sets are small and this avoids the CRT
+static void sort_requests(RESOLVE_REQUEST* requests, DWORD count) {
+    for (DWORD i = 1; i < count; i++) {
+        RESOLVE_REQUEST key = requests[i];
+        DWORD j = i;
+        while (j > 0 && request_less(&key, &requests[j - 1])) {
+            requests[j] = requests[j - 1];
+            j--;
+        }
+        requests[j] = key;
+    }
+}
+
+// Scan one export directory against requests[first..last)
+static DWORD resolve_module_group(HMODULE hModule, RESOLVE_REQUEST* requests,
+                                  DWORD first, DWORD last) {
+    PE_VIEW view;
+    if (!pe_view_get(&view, hModule) || !view.exports) return 0;
+
+    DWORD pending = last - first;
+    DWORD resolved = 0;
+
+    for (DWORD i = 0; i < view.exports->NumberOfNames && pending; i++) {
+        DWORD hash = g_hash_policy->name_hash((char*)(view.base + view.names[i]));
+
+        // Lower bound of hash within the group
+        DWORD lo = first, hi = last;
+        while (lo < hi) {
+            DWORD mid = lo + (hi - lo) / 2;
+            if (requests[mid].function_hash < hash) lo = mid + 1;
+            else hi = mid;
+        }
+
+        // Fill every request for this hash (duplicates allowed); the first
+        // matching name wins, as in find_function_by_hash
+        for (; lo < last && requests[lo].function_hash == hash; lo++) {
+            if (*requests[lo].out) continue;
+
+            FARPROC addr = export_target(&view, export_name_rva(&view, i), 0);
+            if (!addr) continue;
+
+            *requests[lo].out = addr;
+            cache_insert(requests[lo].module_hash, hash,
+                         *module_generation(requests[lo].module_hash), addr);
+            pending--;
+            resolved++;
+        }
+    }
+
+    return resolved;
+}
+
+// Returns the number of requests resolved; unresolved outputs are NULL.
+// Note: reorders the requests array.
+DWORD resolve_batch(RESOLVE_REQUEST* requests, DWORD count) {
+    if (!count) return 0;
+
+    for (DWORD i = 0; i < count; i++) {
+        *requests[i].out = NULL;
+    }
+
+    sort_requests(requests, count);
+
+    // One module cache lookup (at most one PEB walk) per module group
+    DWORD resolved = 0;
+    DWORD first = 0;
+
+    resolve_lock();
+
+    while (first < count) {
+        DWORD last = first + 1;
+        while (last < count && requests[last].module_hash == requests[first].module_hash) {
+            last++;
+        }
+
+        HMODULE hModule = find_module_by_hash(requests[first].module_hash);
+        if (hModule) {
+            resolved += resolve_module_group(hModule, requests, first, last);
+        }
+
+        first = last;
+    }
+
+    resolve_unlock();
+    return resolved;
+}
+
+// ============================================================================
+// HASH COLLISION CHECK
+// ============================================================================
+
+// Validates a policy against what is actually loaded: every export name
+// of every module in the loader list is hashed into a scratch table, and
+// two different names with the same hash in one module count as a
+// collision (the resolver would return whichever comes first). Module
+// names are checked across the whole list. Modules whose exports do not
+// fit in the scratch memory are counted as skipped.
+
+typedef struct {
+    DWORD modules;
+    DWORD exports;
+    DWORD export_collisions;
+    DWORD module_collisions;
+    DWORD skipped;
+} HASH_CHECK_RESULT;
+
+typedef struct {
+    DWORD hash;
+    DWORD name_rva;             // 0 = empty slot
+} HASH_CHECK_SLOT;
+
+static BOOL module_names_equal(PUNICODE_STRING a, PUNICODE_STRING b) {
+    if (a->Length != b->Length) return FALSE;
+
+    for (DWORD i = 0; i < a->Length / sizeof(WCHAR); i++) {
+        WCHAR x = a->Buffer[i], y = b->Buffer[i];
+        if (x >= 'a' && x <= 'z') x -= 0x20;
+        if (y >= 'a' && y <= 'z') y -= 0x20;
+        if (x != y) return FALSE;
+    }
+
+    return TRUE;
+}
+
+static DWORD check_module_exports(const HASH_POLICY* policy, HMODULE hModule,
+                                  HASH_CHECK_SLOT* slots, SIZE_T capacity,
+                                  HASH_CHECK_RESULT* result) {
+    PE_VIEW view;
+    if (!pe_view_init(&view, hModule) || !view.exports) return 0;
+
+    DWORD count = view.exports->NumberOfNames;
+    DWORD size = 16;
+    while (size < count * 2) size <<= 1;
+
+    if (size > capacity) {
+        result->skipped++;
+        return 0;
+    }
+
+    for (DWORD i = 0; i < size; i++) {
+        slots[i].name_rva = 0;
+    }
+
+    DWORD collisions = 0;
+    DWORD mask = size - 1;
+
+    for (DWORD i = 0; i < count; i++) {
+        const char* name = (char*)(view.base + view.names[i]);
+        DWORD hash = policy->name_hash(name);
+        DWORD slot = export_slot_of(hash, mask);
+
+        while (slots[slot].name_rva) {
+            if (slots[slot].hash == hash &&
+                export_name_compare(name, (char*)(view.base + slots[slot].name_rva)) != 0) {
+                collisions++;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        if (!slots[slot].name_rva) {
+            slots[slot].hash = hash;
+            slots[slot].name_rva = view.names[i];
+        }
+    }
+
+    result->exports += count;
+    return collisions;
+}
+
+// scratch: 64 KB covers ntdll's export count
+BOOL hash_policy_check(const HASH_POLICY* policy, void* scratch, SIZE_T size,
+                       HASH_CHECK_RESULT* result) {
+    PLIST_ENTRY pListHead = &get_loader_data()->InMemoryOrderModuleList;
+    HASH_CHECK_SLOT* slots = (HASH_CHECK_SLOT*)scratch;
+    SIZE_T capacity = size / sizeof(HASH_CHECK_SLOT);
+
+    result->modules = 0;
+    result->exports = 0;
+    result->export_collisions = 0;
+    result->module_collisions = 0;
+    result->skipped = 0;
+
+    for (PLIST_ENTRY p = pListHead->Flink; p != pListHead; p = p->Flink) {
+        PLDR_DATA_TABLE_ENTRY pEntry = CONTAINING_RECORD(p, LDR_DATA_TABLE_ENTRY, InMemoryOrderLinks);
+        PUNICODE_STRING name = &pEntry->BaseDllName;
+        DWORD hash = policy->module_hash(name->Buffer, name->Length / sizeof(WCHAR));
+
+        // Against every earlier module (loader lists are short)
+        for (PLIST_ENTRY q = pListHead->Flink; q != p; q = q->Flink) {
+            PLDR_DATA_TABLE_ENTRY pOther = CONTAINING_RECORD(q, LDR_DATA_TABLE_ENTRY, InMemoryOrderLinks);
+            PUNICODE_STRING other = &pOther->BaseDllName;
+
+            if (policy->module_hash(other->Buffer, other->Length / sizeof(WCHAR)) == hash &&
+                !module_names_equal(name, other)) {
+                result->module_collisions++;
+            }
+        }
+
+        result->export_collisions += check_module_exports(
+            policy, (HMODULE)pEntry->DllBase, slots, capacity, result
+        );
+        result->modules++;
+    }
+
+    return result->export_collisions == 0 && result->module_collisions == 0;
+}
+
 // ============================================================================
 // COMMON API HASHES
 // ============================================================================
 
+// Derived from the names at compile time for the default policy (see
+// ror13_hash.h and wfnv_hash.h)
+
 // Module hashes
-#define HASH_KERNEL32           0x6A4ABC5B
-#define HASH_NTDLL              0x3CFA685D
-#define HASH_USER32             0x74FA1C3E
-#define HASH_ADVAPI32           0x85B9F5E2
+#define HASH_KERNEL32           RESOLVER_MODULE_HASH("kernel32.dll")
+#define HASH_NTDLL              RESOLVER_MODULE_HASH("ntdll.dll")
+#define HASH_USER32             RESOLVER_MODULE_HASH("user32.dll")
+#define HASH_ADVAPI32           RESOLVER_MODULE_HASH("advapi32.dll")
 
 // Kernel32 function hashes
-#define HASH_VIRTUALALLOC       0x91AFCA54
-#define HASH_VIRTUALFREE        0x030633D6
-#define HASH_VIRTUALPROTECT     0x7946C61B
-#define HASH_LOADLIBRARYA       0xEC0E4E8E
-#define HASH_GETPROCADDRESS     0x7C0DFCAA
-#define HASH_CREATETHREAD       0x3F9287AE
-#define HASH_WAITFORSINGLEOBJECT 0x601D8708
-#define HASH_SLEEP              0xE035F044
-#define HASH_CREATEFILEA        0x4FDAF6DA
-#define HASH_READFILE           0xBB5F9EAD
-#define HASH_WRITEFILE          0x5BAE572D
-#define HASH_CLOSEHANDLE        0x0FFD97FB
+#define HASH_VIRTUALALLOC       RESOLVER_HASH("VirtualAlloc")
+#define HASH_VIRTUALFREE        RESOLVER_HASH("VirtualFree")
+#define HASH_VIRTUALPROTECT     RESOLVER_HASH("VirtualProtect")
+#define HASH_LOADLIBRARYA       RESOLVER_HASH("LoadLibraryA")
+#define HASH_GETPROCADDRESS     RESOLVER_HASH("GetProcAddress")
+#define HASH_CREATETHREAD       RESOLVER_HASH("CreateThread")
+#define HASH_WAITFORSINGLEOBJECT RESOLVER_HASH("WaitForSingleObject")
+#define HASH_SLEEP              RESOLVER_HASH("Sleep")
+#define HASH_CREATEFILEA        RESOLVER_HASH("CreateFileA")
+#define HASH_READFILE           RESOLVER_HASH("ReadFile")
+#define HASH_WRITEFILE          RESOLVER_HASH("WriteFile")
+#define HASH_CLOSEHANDLE        RESOLVER_HASH("CloseHandle")
+
+// ============================================================================
+// STRING RESOLVER
+// ============================================================================
+
+// dfr "resolve_ext" "strings" entry point: module cache + binary search,
+// loading the module only when it is not already present
+void* resolve_ext(const char* module, const char* function) {
+    resolve_lock();
+    HMODULE hModule = find_module_by_hash(ascii_module_hash(module, (DWORD)-1));
+    resolve_unlock();
+
+    if (!hModule) {
+        typedef HMODULE (WINAPI *pLoadLibraryA)(LPCSTR);
+        // Hashed at runtime so this follows resolver_set_hash_policy()
+        pLoadLibraryA LoadLibraryA = (pLoadLibraryA)resolve_cached(
+            ascii_module_hash("kernel32", 8),
+            g_hash_policy->name_hash("LoadLibraryA")
+        );
+
+        if (!LoadLibraryA) return NULL;
+        hModule = LoadLibraryA(module);
+    }
+
+    // LoadLibraryA runs outside the lock (DllMain may resolve too)
+    resolve_lock();
+    void* addr = (void*)find_function_by_name(hModule, function);
+    resolve_unlock();
+
+    return addr;
+}
+
+// ============================================================================
+// MODULE UNLOAD TRACKING
+// ============================================================================
+
+// A module that is unloaded takes only its own entries with it: its
+// generation is bumped (resolver cache entries for it stop matching) and
+// its module cache entry, PE view and export index are dropped. Entries
+// for every other module stay hot, so modules that come and go (winhttp,
+// wininet, ...) can be resolved through the cache like everything else.
+//
+// resolver_watch_unloads() gets this called automatically through ntdll's
+// DLL notifications (LdrRegisterDllNotification, resolved by hash); code
+// that cannot keep a callback registered calls resolver_module_unloaded()
+// itself after FreeLibrary.
+//
+// The unload notification arrives before the loader unlinks the module,
+// so on that path its base is skipped by the module walks while it is
+// still linked (g_unloading_bases). The manual path only runs after
+// FreeLibrary returned, so there is nothing to skip: the module is gone,
+// still loaded (other references) or already back, and the next lookup
+// re-walks the list to find out.
+//
+// Not covered: addresses in other modules' entries that came from a
+// forwarder into the unloaded module, and bound LAZY_SLOTs (lazy_unbind
+// them).
+
+#define LDR_DLL_NOTIFICATION_REASON_LOADED   1
+#define LDR_DLL_NOTIFICATION_REASON_UNLOADED 2
+
+typedef struct {
+    ULONG Flags;
+    PCUNICODE_STRING FullDllName;
+    PCUNICODE_STRING BaseDllName;
+    PVOID DllBase;
+    ULONG SizeOfImage;
+} DLL_NOTIFICATION_DATA;       // Same layout for loads and unloads
+
+typedef VOID (CALLBACK *pLdrDllNotification)(ULONG, const DLL_NOTIFICATION_DATA*, PVOID);
+typedef LONG (NTAPI *pLdrRegisterDllNotification)(ULONG, pLdrDllNotification, PVOID, PVOID*);
+typedef LONG (NTAPI *pLdrUnregisterDllNotification)(PVOID);
+
+PVOID g_unload_cookie = NULL;
+
+// Caller holds g_resolve_lock
+static void module_unloaded(HMODULE hModule, DWORD module_hash) {
+    InterlockedIncrement(module_generation(module_hash));
+    module_cache_drop(hModule);
+    if (g_export_arena) {
+        export_index_drop(g_export_arena, hModule);
+    }
+}
+
+// Manual path, after FreeLibrary
+void resolver_module_unloaded(HMODULE hModule, DWORD module_hash) {
+    resolve_lock();
+
+    module_unloaded(hModule, module_hash);
+    g_module_cache.valid = FALSE;
+
+    resolve_unlock();
+}
+
+// Runs on the unloading thread with the loader lock held; takes only
+// g_resolve_lock, which is never held across loader calls
+static VOID CALLBACK resolver_dll_notification(ULONG reason,
+                                               const DLL_NOTIFICATION_DATA* data,
+                                               PVOID context) {
+    resolve_lock();
+
+    if (reason == LDR_DLL_NOTIFICATION_REASON_UNLOADED) {
+        unloading_add(data->DllBase);
+        module_unloaded((HMODULE)data->DllBase,
+                        module_name_hash((PUNICODE_STRING)data->BaseDllName));
+    } else if (reason == LDR_DLL_NOTIFICATION_REASON_LOADED) {
+        unloading_remove(data->DllBase);
+    }
+
+    resolve_unlock();
+}
+
+// The callback must stay mapped while registered: call
+// resolver_unwatch_unloads() before freeing the code that holds it
+BOOL resolver_watch_unloads(void) {
+    if (g_unload_cookie) return TRUE;
+
+    pLdrRegisterDllNotification LdrRegisterDllNotification =
+        (pLdrRegisterDllNotification)resolve_cached(
+            ascii_module_hash("ntdll", 5),
+            g_hash_policy->name_hash("LdrRegisterDllNotification")
+        );
+
+    if (!LdrRegisterDllNotification) return FALSE;
+    return LdrRegisterDllNotification(0, resolver_dll_notification, NULL,
+                                      &g_unload_cookie) == 0;
+}
+
+void resolver_unwatch_unloads(void) {
+    if (!g_unload_cookie) return;
+
+    pLdrUnregisterDllNotification LdrUnregisterDllNotification =
+        (pLdrUnregisterDllNotification)resolve_cached(
+            ascii_module_hash("ntdll", 5),
+            g_hash_policy->name_hash("LdrUnregisterDllNotification")
+        );
+
+    if (LdrUnregisterDllNotification) {
+        LdrUnregisterDllNotification(g_unload_cookie);
+    }
+    g_unload_cookie = NULL;
+}
+
+// ============================================================================
+// LAZY BINDING
+// ============================================================================
+
+// Import slots that resolve on first call instead of at startup:
+//
+//   LAZY_IMPORT(VirtualAlloc, HASH_KERNEL32, HASH_VIRTUALALLOC);
+//   ...
+//   LAZY(pVirtualAlloc, VirtualAlloc)(NULL, 0x1000, MEM_COMMIT, PAGE_READWRITE);
+//
+// Each slot starts out pointing at its own stub. The first call lands in
+// lazy_bind_common, which saves the argument registers, resolves through
+// resolve_cached(), patches the slot and jumps to the real function with
+// the caller's arguments intact; later calls go straight through the
+// slot. Startup cost scales with the APIs actually called.
+//
+// Slots are globals (PICOs, DLLs; PIC needs a writable home for them).
+// A missing export binds to lazy_missing, which returns 0. The hashes
+// are baked in, so slots follow the compile-time hash policy. x64 only.
+
+#ifdef _WIN64
+
+typedef struct {
+    FARPROC address;            // Stub until bound, then the real export
+    FARPROC stub;
+    DWORD module_hash;
+    DWORD function_hash;
+} LAZY_SLOT;
+
+#define LAZY_IMPORT(name, module_hash, function_hash)                       \
+    extern LAZY_SLOT lazy_##name;                                           \
+    void lazy_stub_##name(void);                                            \
+    __asm__(                                                                \
+        ".text\n"                                                           \
+        ".p2align 4\n"                                                      \
+        "lazy_stub_" #name ":\n"                                            \
+        "    lea  lazy_" #name "(%rip), %rax\n"                             \
+        "    jmp  lazy_bind_common\n"                                       \
+    );                                                                      \
+    LAZY_SLOT lazy_##name = {                                               \
+        (FARPROC)lazy_stub_##name, (FARPROC)lazy_stub_##name,               \
+        module_hash, function_hash                                          \
+    }
+
+#define LAZY(type, name) ((type)lazy_##name.address)
+
+static ULONG_PTR WINAPI lazy_missing(void) {
+    return 0;
+}
+
+// Called from lazy_bind_common with the slot; returns the target. Two
+// threads binding the same slot store the same address.
+FARPROC lazy_bind(LAZY_SLOT* slot) {
+    FARPROC addr = resolve_cached(slot->module_hash, slot->function_hash);
+    if (!addr) addr = (FARPROC)lazy_missing;
+
+    slot->address = addr;
+    return addr;
+}
+
+// Back to the stub, e.g. after the module was unloaded
+void lazy_unbind(LAZY_SLOT* slot) {
+    slot->address = slot->stub;
+}
+
+// rax = slot. Entry rsp is 8 mod 16 (the caller's return address); four
+// pushes keep that and 0x68 re-aligns it with room for the shadow space
+// and xmm0-3 (float arguments).
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    ".globl lazy_bind_common\n"
+    "lazy_bind_common:\n"
+    "    push %rcx\n"
+    "    push %rdx\n"
+    "    push %r8\n"
+    "    push %r9\n"
+    "    sub  $0x68, %rsp\n"
+    "    movdqa %xmm0, 0x20(%rsp)\n"
+    "    movdqa %xmm1, 0x30(%rsp)\n"
+    "    movdqa %xmm2, 0x40(%rsp)\n"
+    "    movdqa %xmm3, 0x50(%rsp)\n"
+    "    mov  %rax, %rcx\n"
+    "    call lazy_bind\n"
+    "    movdqa 0x20(%rsp), %xmm0\n"
+    "    movdqa 0x30(%rsp), %xmm1\n"
+    "    movdqa 0x40(%rsp), %xmm2\n"
+    "    movdqa 0x50(%rsp), %xmm3\n"
+    "    add  $0x68, %rsp\n"
+    "    pop  %r9\n"
+    "    pop  %r8\n"
+    "    pop  %rdx\n"
+    "    pop  %rcx\n"
+    "    jmp  *%rax\n"
+);
+
+#endif // _WIN64
+
+#ifndef RESOLVER_NO_EXAMPLES
 
 // ============================================================================
 // EXAMPLE USAGE
 // ============================================================================
 
 void example_usage(void) {
+    // Index exports on first touch (ntdll's ~2,500 names need 32 KB)
+    static BYTE arena_memory[64 * 1024];
+    static EXPORT_INDEX_ARENA arena;
+    export_index_arena_init(&arena, arena_memory, sizeof(arena_memory));
+    resolver_set_export_arena(&arena);
+
+    // FreeLibrary on any module drops just that module's cached entries
+    resolver_watch_unloads();
+
     // Resolve VirtualAlloc
     typedef LPVOID (WINAPI *pVirtualAlloc)(LPVOID, SIZE_T, DWORD, DWORD);
     pVirtualAlloc VirtualAlloc = (pVirtualAlloc)resolve_cached(
@@ -223,40 +1537,79 @@ void example_usage(void) {
         HANDLE hThread = CreateThread(NULL, 0, my_thread_func, NULL, 0, NULL);
         // Use hThread...
     }
+
+    // Check the cache hit rate
+    CACHE_STATS stats;
+    resolve_cache_stats(&stats);
+    // stats.hits / (stats.hits + stats.misses)
 }
 
+void example_usage_batch(void) {
+    // Resolve the full import set up front: one export scan per module
+    FARPROC pVirtualAlloc, pVirtualProtect, pCreateThread, pSleep;
+
+    RESOLVE_REQUEST imports[] = {
+        { HASH_KERNEL32, HASH_VIRTUALALLOC,   &pVirtualAlloc },
+        { HASH_KERNEL32, HASH_VIRTUALPROTECT, &pVirtualProtect },
+        { HASH_KERNEL32, HASH_CREATETHREAD,   &pCreateThread },
+        { HASH_KERNEL32, HASH_SLEEP,          &pSleep },
+    };
+
+    DWORD count = sizeof(imports) / sizeof(imports[0]);
+    if (resolve_batch(imports, count) != count) {
+        // At least one import missing (each unresolved pointer is NULL)
+    }
+
+    // Later resolve_cached() calls for these hashes are cache hits
+}
+
+#ifdef _WIN64
+
+// Referenced up front, resolved only if called
+LAZY_IMPORT(VirtualAlloc, HASH_KERNEL32, HASH_VIRTUALALLOC);
+LAZY_IMPORT(VirtualProtect, HASH_KERNEL32, HASH_VIRTUALPROTECT);
+LAZY_IMPORT(CreateThread, HASH_KERNEL32, HASH_CREATETHREAD);
+
+void example_usage_lazy(void) {
+    typedef LPVOID (WINAPI *pVirtualAlloc)(LPVOID, SIZE_T, DWORD, DWORD);
+
+    // First call binds the slot, the second goes straight to kernel32;
+    // VirtualProtect and CreateThread are never resolved
+    void* a = LAZY(pVirtualAlloc, VirtualAlloc)(NULL, 0x1000, MEM_COMMIT, PAGE_READWRITE);
+    void* b = LAZY(pVirtualAlloc, VirtualAlloc)(NULL, 0x1000, MEM_COMMIT, PAGE_READWRITE);
+    // Use a, b...
+}
+
+#endif // _WIN64
+
+#endif // RESOLVER_NO_EXAMPLES
+
 // ============================================================================
-// HASH GENERATOR UTILITY
+// HASH SELF-CHECK
 // ============================================================================
 
-void generate_hashes(void) {
-    // Example: Generate hash for a new API
+// Confirms the compile-time macros agree with the runtime hashes, e.g.
+// after porting to a new compiler. Returns FALSE on the first mismatch.
+BOOL verify_hashes(void) {
+    WCHAR kernel32[] = { 'k','e','r','n','e','l','3','2','.','d','l','l' };
+    DWORD length = sizeof(kernel32) / sizeof(WCHAR);
 
-    const char* modules[] = {
-        "KERNEL32.DLL",
-        "NTDLL.DLL",
-        "USER32.DLL",
-        "ADVAPI32.DLL",
-        NULL
-    };
+    if (ror13_module_hash(kernel32, length) != ROR13_MODULE("kernel32.dll")) return FALSE;
+    if (ror13_hash("VirtualAlloc") != ROR13("VirtualAlloc")) return FALSE;
+    if (ror13_hash("CreateThread") != ROR13("CreateThread")) return FALSE;
+    if (ror13_hash("LoadLibraryA") != ROR13("LoadLibraryA")) return FALSE;
+    if (ror13_hash("GetProcAddress") != ROR13("GetProcAddress")) return FALSE;
 
-    const char* functions[] = {
-        "VirtualAlloc",
-        "CreateThread",
-        "LoadLibraryA",
-        "GetProcAddress",
-        NULL
-    };
+    // wfnv: word-boundary lengths (8, 16) included
+    if (wfnv_module_hash(kernel32, length) != WFNV_MODULE("kernel32.dll")) return FALSE;
+    if (wfnv_hash("VirtualAlloc") != WFNV("VirtualAlloc")) return FALSE;
+    if (wfnv_hash("ReadFile") != WFNV("ReadFile")) return FALSE;
+    if (wfnv_hash("VirtualProtectEx") != WFNV("VirtualProtectEx")) return FALSE;
+    if (wfnv_hash("WaitForSingleObject") != WFNV("WaitForSingleObject")) return FALSE;
 
-    // Generate module hashes
-    for (int i = 0; modules[i]; i++) {
-        DWORD hash = ror13_hash(modules[i]);
-        // Output: #define HASH_<MODULE> 0x<hash>
-    }
+    // The HASH_* constants follow the active policy
+    if (g_hash_policy->module_hash(kernel32, length) != HASH_KERNEL32) return FALSE;
+    if (g_hash_policy->name_hash("VirtualAlloc") != HASH_VIRTUALALLOC) return FALSE;
 
-    // Generate function hashes
-    for (int i = 0; functions[i]; i++) {
-        DWORD hash = ror13_hash(functions[i]);
-        // Output: #define HASH_<FUNCTION> 0x<hash>
-    }
+    return TRUE;
 }
@@ -0,0 +1,53 @@
+/*
+ * Compile-Time Word FNV Hashes
+ *
+ * FNV-1a over 8-byte little-endian words instead of bytes: one xor and
+ * one 64-bit multiply per 8 characters, then a length mix and a fold to
+ * 32 bits. The last word is zero-padded.
+ *
+ *   #define HASH_VIRTUALALLOC  WFNV("VirtualAlloc")
+ *   #define HASH_KERNEL32      WFNV_MODULE("kernel32.dll")
+ *
+ * WFNV() matches wfnv_hash() and WFNV_MODULE() matches wfnv_module_hash()
+ * (a-z uppercased, one byte per character) in ror13_resolver.c. Same
+ * folding rules and length limit as ror13_hash.h.
+ */
+
+#ifndef WFNV_HASH_H
+#define WFNV_HASH_H
+
+#include "ror13_hash.h"
+
+#define WFNV_OFFSET 0xCBF29CE484222325ULL
+#define WFNV_PRIME  0x00000100000001B3ULL
+
+// Byte k (0-7) of word w, shifted into place
+#define WFNV_B(C, s, w, k)  ((unsigned long long)C(s, (w) * 8 + (k)) << ((k) * 8))
+
+#define WFNV_WORD(C, s, w) \
+    (WFNV_B(C, s, w, 0) | WFNV_B(C, s, w, 1) | WFNV_B(C, s, w, 2) | WFNV_B(C, s, w, 3) | \
+     WFNV_B(C, s, w, 4) | WFNV_B(C, s, w, 5) | WFNV_B(C, s, w, 6) | WFNV_B(C, s, w, 7))
+
+// Words past the end of the string multiply by 1 and xor 0 (no-op), so
+// each step still uses h exactly once
+#define WFNV_STEP(C, s, w, h) \
+    (((h) ^ ((w) * 8 < sizeof(s) - 1 ? WFNV_WORD(C, s, w) : 0)) * \
+     ((w) * 8 < sizeof(s) - 1 ? WFNV_PRIME : 1ULL))
+
+#define WFNV_64(C, s) \
+    WFNV_STEP(C, s, 7, WFNV_STEP(C, s, 6, WFNV_STEP(C, s, 5, WFNV_STEP(C, s, 4, \
+    WFNV_STEP(C, s, 3, WFNV_STEP(C, s, 2, WFNV_STEP(C, s, 1, WFNV_STEP(C, s, 0, \
+    WFNV_OFFSET))))))))
+
+#define WFNV_FOLD(x)  ((DWORD)(((x) ^ ((x) >> 32)) & 0xFFFFFFFFULL))
+#define WFNV_FINISH(h, length)  WFNV_FOLD(((h) ^ (unsigned long long)(length)) * WFNV_PRIME)
+
+// Function names (wfnv_hash)
+#define WFNV(s) \
+    ((DWORD)(WFNV_FINISH(WFNV_64(ROR13_CHAR, s), sizeof(s) - 1) + ROR13_CHECK_LENGTH(s)))
+
+// Module names (wfnv_module_hash over BaseDllName)
+#define WFNV_MODULE(s) \
+    ((DWORD)(WFNV_FINISH(WFNV_64(ROR13_UPPER, s), sizeof(s) - 1) + ROR13_CHECK_LENGTH(s)))
+
+#endif // WFNV_HASH_H
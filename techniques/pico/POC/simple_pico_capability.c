@@ -4,20 +4,29 @@
  * Demonstrates a PICO capability with:
  * - Entry point (go)
  * - Multiple exported functions
- * - Resource access
+ * - Resource access (versioned config read in place)
+ * - Arena allocator for instance scratch memory
+ * - Event-driven execute loop (signal/stop exports, sleep_time as timeout)
  *
  * Build with Crystal Palace:
  *   load "simple_pico_capability.x64.o"
  *     exportfunc "capability_init" "__tag_init"
  *     exportfunc "capability_execute" "__tag_execute"
  *     exportfunc "capability_cleanup" "__tag_cleanup"
+ *     exportfunc "capability_signal" "__tag_signal"
+ *     exportfunc "capability_stop" "__tag_stop"
  *     make pico +optimize
  *   load "config.bin"
  *     append $PICO
  *   link "simple_capability.pico"
+ *
+ * -DPIC_PROFILE times the go() lifecycle phases and reports them through
+ * OutputDebugStringA (tradecraft-debugging/POC/phase_profile.h).
  */
 
 #include <windows.h>
+#include <tlhelp32.h>
+#include "../../tradecraft-debugging/POC/phase_profile.h"
 
 // ============================================================================
 // CONFIGURATION
@@ -27,60 +36,543 @@
 extern unsigned char _binary_config_bin_start[];
 extern unsigned int  _binary_config_bin_size;
 
+// config.bin layout (all fields little-endian, read in place):
+//
+//   CONFIG_HEADER                     magic "PCFG", version, section count
+//   CONFIG_SECTION_ENTRY[count]       id, flags, offset, size, key
+//   section data...
+//
+// Offsets are from the start of config.bin. Unknown section ids are
+// ignored, so newer builders can add sections without breaking old PICOs.
+// A config.bin without the magic is read as the original flat CONFIG.
+
+#define CONFIG_MAGIC        0x47464350  // "PCFG"
+#define CONFIG_VERSION      1
+
+#define CONFIG_SECTION_TIMING  1        // DWORD sleep_time, DWORD max_iterations
+#define CONFIG_SECTION_TARGET  2        // NUL-terminated process name
+
+// Section is XOR-masked with its key and lands in .bss on first access
+#define CONFIG_FLAG_MASKED  0x0001
+
+#pragma pack(push, 1)
+typedef struct {
+    DWORD magic;
+    WORD version;
+    WORD section_count;
+} CONFIG_HEADER;
+
+typedef struct {
+    WORD id;
+    WORD flags;
+    DWORD offset;
+    DWORD size;
+    DWORD key;
+} CONFIG_SECTION_ENTRY;
+#pragma pack(pop)
+
+// Original flat layout, still accepted
 typedef struct {
     DWORD sleep_time;
     DWORD max_iterations;
     char target_process[256];
 } CONFIG;
 
-CONFIG g_config = {0};
-
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
 
-// Simple string length
+// Word-at-a-time versions: aligned 8-byte words (16 with SSE2) in the
+// middle, bytes for the unaligned head and the tail. Aligned loads never
+// cross a page, so reading past a terminator inside the last word is safe.
+//
+// Build with -DPICO_USE_SSE2 to take the 16-byte SSE2 paths (always
+// available on x64).
+
+typedef UINT64 __attribute__((may_alias)) PICO_WORD;
+typedef UINT64 __attribute__((may_alias, aligned(1))) PICO_UWORD;
+
+#define PICO_ONES  0x0101010101010101ULL
+#define PICO_HIGHS 0x8080808080808080ULL
+
+// High bit set in each byte of v that is zero (exact up to the first zero)
+#define PICO_ZERO_BYTES(v) (((v) - PICO_ONES) & ~(v) & PICO_HIGHS)
+
+// Keep GCC from turning the copy loops back into a memcpy call
+#define PICO_NO_BUILTIN __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+#ifdef PICO_USE_SSE2
+#include <emmintrin.h>
+#define PICO_ALIGN 16
+#else
+#define PICO_ALIGN 8
+#endif
+
+#define PICO_MISALIGNED(p) ((ULONG_PTR)(p) & (PICO_ALIGN - 1))
+
+// String length
 int my_strlen(const char* str) {
-    int len = 0;
-    while (str[len]) len++;
-    return len;
+    const char* p = str;
+
+    while (PICO_MISALIGNED(p)) {
+        if (!*p) return (int)(p - str);
+        p++;
+    }
+
+#ifdef PICO_USE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    for (;;) {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero));
+        if (mask) return (int)(p - str) + __builtin_ctz(mask);
+        p += 16;
+    }
+#else
+    for (;;) {
+        UINT64 zeros = PICO_ZERO_BYTES(*(const PICO_WORD*)p);
+        if (zeros) return (int)(p - str) + (__builtin_ctzll(zeros) >> 3);
+        p += 8;
+    }
+#endif
 }
 
-// Simple string compare
+// String compare
 int my_strcmp(const char* a, const char* b) {
+    // Words only line up when both strings share the same misalignment
+    if (PICO_MISALIGNED(a) == PICO_MISALIGNED(b)) {
+        while (PICO_MISALIGNED(a)) {
+            if (!*a || *a != *b) return (unsigned char)*a - (unsigned char)*b;
+            a++;
+            b++;
+        }
+
+#ifdef PICO_USE_SSE2
+        __m128i zero = _mm_setzero_si128();
+        for (;;) {
+            __m128i wa = _mm_load_si128((const __m128i*)a);
+            __m128i wb = _mm_load_si128((const __m128i*)b);
+            int differ = _mm_movemask_epi8(_mm_cmpeq_epi8(wa, wb)) ^ 0xFFFF;
+            int ends = _mm_movemask_epi8(_mm_cmpeq_epi8(wa, zero));
+            if (differ | ends) {
+                int i = __builtin_ctz(differ | ends);
+                return (unsigned char)a[i] - (unsigned char)b[i];
+            }
+            a += 16;
+            b += 16;
+        }
+#else
+        // Stop at the word holding the first difference or terminator
+        while (*(const PICO_WORD*)a == *(const PICO_WORD*)b &&
+               !PICO_ZERO_BYTES(*(const PICO_WORD*)a)) {
+            a += 8;
+            b += 8;
+        }
+#endif
+    }
+
     while (*a && (*a == *b)) {
         a++;
         b++;
     }
-    return *a - *b;
+    return (unsigned char)*a - (unsigned char)*b;
 }
 
-// Simple memory copy
+// Memory copy
+PICO_NO_BUILTIN
 void* my_memcpy(void* dest, const void* src, size_t n) {
-    char* d = (char*)dest;
-    const char* s = (const char*)src;
-    for (size_t i = 0; i < n; i++) {
-        d[i] = s[i];
+    unsigned char* d = (unsigned char*)dest;
+    const unsigned char* s = (const unsigned char*)src;
+
+    if (n >= 2 * PICO_ALIGN) {
+        // Head: align the destination, source loads may stay unaligned
+        while (PICO_MISALIGNED(d)) {
+            *d++ = *s++;
+            n--;
+        }
+
+#ifdef PICO_USE_SSE2
+        for (; n >= 16; n -= 16, d += 16, s += 16) {
+            _mm_store_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+        }
+#endif
+        for (; n >= 8; n -= 8, d += 8, s += 8) {
+            *(PICO_WORD*)d = *(const PICO_UWORD*)s;
+        }
+    }
+
+    // Tail (and short copies)
+    while (n--) {
+        *d++ = *s++;
     }
     return dest;
 }
 
+// Zero memory that is about to go out of use (keys, config, results).
+// Same head/word/tail shape as my_memcpy; the empty asm with a memory
+// clobber makes the stores observable, so dead-store elimination and
+// loop-to-memset rewriting cannot drop them.
+PICO_NO_BUILTIN
+void my_secure_zero(void* dest, size_t n) {
+    unsigned char* d = (unsigned char*)dest;
+
+    if (n >= 2 * PICO_ALIGN) {
+        while (PICO_MISALIGNED(d)) {
+            *d++ = 0;
+            n--;
+        }
+
+#ifdef PICO_USE_SSE2
+        __m128i zero = _mm_setzero_si128();
+        for (; n >= 16; n -= 16, d += 16) {
+            _mm_store_si128((__m128i*)d, zero);
+        }
+#endif
+        for (; n >= 8; n -= 8, d += 8) {
+            *(PICO_WORD*)d = 0;
+        }
+    }
+
+    while (n--) {
+        *d++ = 0;
+    }
+
+    __asm__ __volatile__("" : : "r"(dest) : "memory");
+}
+
+// ============================================================================
+// ARENA ALLOCATOR
+// ============================================================================
+
+// Instance scratch memory without heap calls or large stack frames. One
+// region is reserved at capability_init and committed in
+// ARENA_COMMIT_STEP pieces as the bump pointer reaches them. Allocations
+// are never freed one by one: arena_mark/arena_release scope per-task
+// scratch, arena_reset drops everything in O(1), and arena_close wipes
+// what was used and releases the region.
+//
+// Memory from the arena is not zeroed after a reset or release.
+
+#define ARENA_RESERVE       (1024 * 1024)
+#define ARENA_COMMIT_STEP   (64 * 1024)
+#define ARENA_ALIGN         16
+
+typedef struct {
+    BYTE* base;
+    SIZE_T reserved;
+    SIZE_T committed;
+    SIZE_T used;
+    SIZE_T high_water;          // Largest used, for the wipe at close
+} PICO_ARENA;
+
+PICO_ARENA g_arena = {0};
+
+BOOL arena_open(PICO_ARENA* arena, SIZE_T reserve) {
+    arena->base = (BYTE*)VirtualAlloc(NULL, reserve, MEM_RESERVE, PAGE_READWRITE);
+    arena->reserved = arena->base ? reserve : 0;
+    arena->committed = 0;
+    arena->used = 0;
+    arena->high_water = 0;
+    return arena->base != NULL;
+}
+
+// ARENA_ALIGN-aligned, NULL once the reservation is exhausted
+void* arena_alloc(PICO_ARENA* arena, SIZE_T size) {
+    SIZE_T start = (arena->used + ARENA_ALIGN - 1) & ~(SIZE_T)(ARENA_ALIGN - 1);
+
+    if (!arena->base || start > arena->reserved || size > arena->reserved - start) return NULL;
+
+    SIZE_T end = start + size;
+
+    if (end > arena->committed) {
+        SIZE_T commit_end = (end + ARENA_COMMIT_STEP - 1) & ~(SIZE_T)(ARENA_COMMIT_STEP - 1);
+        if (commit_end > arena->reserved) commit_end = arena->reserved;
+
+        if (!VirtualAlloc(arena->base + arena->committed, commit_end - arena->committed,
+                          MEM_COMMIT, PAGE_READWRITE)) {
+            return NULL;
+        }
+        arena->committed = commit_end;
+    }
+
+    arena->used = end;
+    if (end > arena->high_water) arena->high_water = end;
+    return arena->base + start;
+}
+
+// Scope scratch: everything allocated after the mark goes at release
+SIZE_T arena_mark(PICO_ARENA* arena) {
+    return arena->used;
+}
+
+void arena_release(PICO_ARENA* arena, SIZE_T mark) {
+    if (mark <= arena->used) arena->used = mark;
+}
+
+void arena_reset(PICO_ARENA* arena) {
+    arena->used = 0;
+}
+
+void arena_close(PICO_ARENA* arena) {
+    if (arena->base) {
+        my_secure_zero(arena->base, arena->high_water);
+        VirtualFree(arena->base, 0, MEM_RELEASE);
+    }
+
+    arena->base = NULL;
+    arena->reserved = 0;
+    arena->committed = 0;
+    arena->used = 0;
+    arena->high_water = 0;
+}
+
+// ============================================================================
+// CONFIGURATION ACCESS
+// ============================================================================
+
+// Most sections are read where they sit in the appended resource; only
+// masked ones are copied, once, into the landing area.
+#define CONFIG_MAX_SECTIONS 16
+#define CONFIG_LANDING_SIZE 4096
+
+typedef struct {
+    const BYTE* base;                   // Appended config.bin
+    DWORD size;
+    const CONFIG_SECTION_ENTRY* sections;
+    DWORD section_count;
+    const BYTE* landed[CONFIG_MAX_SECTIONS];
+    DWORD landing_used;
+} CONFIG_VIEW;
+
+CONFIG_VIEW g_config_view = {0};
+BYTE g_config_landing[CONFIG_LANDING_SIZE];
+
+// The flat CONFIG seen as two sections
+static const CONFIG_SECTION_ENTRY g_legacy_sections[] = {
+    { CONFIG_SECTION_TIMING, 0, 0, 2 * sizeof(DWORD), 0 },
+    { CONFIG_SECTION_TARGET, 0, 2 * sizeof(DWORD), 256, 0 },
+};
+
+// Validate the header and section table in place; nothing is copied.
+// Returns FALSE if there is no usable config (accessors then use defaults).
+BOOL config_open(void) {
+    CONFIG_VIEW* view = &g_config_view;
+    const BYTE* base = _binary_config_bin_start;
+    DWORD size = _binary_config_bin_size;
+
+    view->base = base;
+    view->size = size;
+    view->sections = NULL;
+    view->section_count = 0;
+    view->landing_used = 0;
+    for (DWORD i = 0; i < CONFIG_MAX_SECTIONS; i++) view->landed[i] = NULL;
+
+    const CONFIG_HEADER* header = (const CONFIG_HEADER*)base;
+
+    if (size < sizeof(CONFIG_HEADER) || header->magic != CONFIG_MAGIC) {
+        if (size < sizeof(CONFIG)) return FALSE;
+        view->sections = g_legacy_sections;
+        view->section_count = sizeof(g_legacy_sections) / sizeof(g_legacy_sections[0]);
+        return TRUE;
+    }
+
+    if (header->version != CONFIG_VERSION) return FALSE;
+
+    DWORD count = header->section_count;
+    if (count > (size - sizeof(CONFIG_HEADER)) / sizeof(CONFIG_SECTION_ENTRY)) return FALSE;
+
+    view->sections = (const CONFIG_SECTION_ENTRY*)(base + sizeof(CONFIG_HEADER));
+    view->section_count = count < CONFIG_MAX_SECTIONS ? count : CONFIG_MAX_SECTIONS;
+    return TRUE;
+}
+
+// Data of section id, or NULL if absent or out of bounds. Masked sections
+// are unmasked into the landing area the first time they are touched.
+const BYTE* config_section(WORD id, DWORD* size) {
+    CONFIG_VIEW* view = &g_config_view;
+
+    for (DWORD i = 0; i < view->section_count; i++) {
+        const CONFIG_SECTION_ENTRY* entry = &view->sections[i];
+        if (entry->id != id) continue;
+
+        if (entry->offset > view->size || entry->size > view->size - entry->offset) return NULL;
+        *size = entry->size;
+
+        if (!(entry->flags & CONFIG_FLAG_MASKED)) return view->base + entry->offset;
+        if (view->landed[i]) return view->landed[i];
+
+        // Land it (8-byte aligned), unmasking with the little-endian key
+        DWORD start = (view->landing_used + 7) & ~7u;
+        if (entry->size > CONFIG_LANDING_SIZE - start) return NULL;
+
+        BYTE* dest = g_config_landing + start;
+        const BYTE* src = view->base + entry->offset;
+        for (DWORD b = 0; b < entry->size; b++) {
+            dest[b] = src[b] ^ (BYTE)(entry->key >> ((b & 3) * 8));
+        }
+
+        view->landing_used = start + entry->size;
+        view->landed[i] = dest;
+        return dest;
+    }
+
+    return NULL;
+}
+
+// DWORD at offset within a section, or fallback
+DWORD config_dword(WORD id, DWORD offset, DWORD fallback) {
+    DWORD size;
+    const BYTE* data = config_section(id, &size);
+
+    if (!data || offset > size || size - offset < sizeof(DWORD)) return fallback;
+
+    DWORD value;
+    my_memcpy(&value, data + offset, sizeof(DWORD));    // May be unaligned
+    return value;
+}
+
+// NUL-terminated string section, or fallback if absent or unterminated
+const char* config_string(WORD id, const char* fallback) {
+    DWORD size;
+    const char* data = (const char*)config_section(id, &size);
+
+    if (!data) return fallback;
+
+    for (DWORD i = 0; i < size; i++) {
+        if (!data[i]) return data;
+    }
+    return fallback;
+}
+
+DWORD config_sleep_time(void) {
+    return config_dword(CONFIG_SECTION_TIMING, 0, 1000);
+}
+
+DWORD config_max_iterations(void) {
+    return config_dword(CONFIG_SECTION_TIMING, sizeof(DWORD), 10);
+}
+
+const char* config_target_process(void) {
+    return config_string(CONFIG_SECTION_TARGET, "explorer.exe");
+}
+
+// ============================================================================
+// WORK SIGNALS
+// ============================================================================
+
+// capability_execute blocks in one WaitForMultipleObjects on a small set
+// of handles instead of sleeping a fixed sleep_time per iteration:
+//
+//   [0] stop event       capability_stop(): leave the loop now
+//   [1] work event       capability_signal(): work is queued
+//   [2..] extra handles  capability_add_wait_handle(): auto-reset objects
+//                        owned by the caller
+//
+// New work is picked up as soon as it is signaled; sleep_time stays the
+// upper bound between passes. A pass that times out is a check-in only:
+// no task scratch, no task body.
+//
+// Extra handles must be reset by the wait that wakes the loop: auto-reset
+// events, synchronization (auto-reset) waitable timers, semaphores.
+// Processes, threads, manual-reset events and timers stay signaled, so
+// every wait would return at once and the loop would spin through
+// max_iterations. For sockets or pipes, signal an auto-reset event from
+// the I/O completion and add that event instead.
+
+#define WAIT_SLOT_STOP      0
+#define WAIT_SLOT_WORK      1
+#define WAIT_MAX_HANDLES    8
+
+typedef struct {
+    HANDLE handles[WAIT_MAX_HANDLES];
+    DWORD count;                // 0 = events unavailable, poll with Sleep
+} WAIT_SET;
+
+WAIT_SET g_wait_set = {0};
+
+BOOL wait_set_open(WAIT_SET* set) {
+    set->count = 0;
+    set->handles[WAIT_SLOT_STOP] = CreateEventA(NULL, TRUE, FALSE, NULL);   // Manual: stays set
+    set->handles[WAIT_SLOT_WORK] = CreateEventA(NULL, FALSE, FALSE, NULL);  // Auto
+
+    if (!set->handles[WAIT_SLOT_STOP] || !set->handles[WAIT_SLOT_WORK]) {
+        if (set->handles[WAIT_SLOT_STOP]) CloseHandle(set->handles[WAIT_SLOT_STOP]);
+        if (set->handles[WAIT_SLOT_WORK]) CloseHandle(set->handles[WAIT_SLOT_WORK]);
+        set->handles[WAIT_SLOT_STOP] = NULL;
+        set->handles[WAIT_SLOT_WORK] = NULL;
+        return FALSE;
+    }
+
+    set->count = 2;
+    return TRUE;
+}
+
+// Only the two events are ours; extra handles belong to whoever added them
+void wait_set_close(WAIT_SET* set) {
+    if (set->count) {
+        CloseHandle(set->handles[WAIT_SLOT_STOP]);
+        CloseHandle(set->handles[WAIT_SLOT_WORK]);
+    }
+
+    for (DWORD i = 0; i < WAIT_MAX_HANDLES; i++) {
+        set->handles[i] = NULL;
+    }
+    set->count = 0;
+}
+
+// Slot that woke us, or WAIT_TIMEOUT after timeout ms with nothing signaled
+DWORD wait_set_wait(WAIT_SET* set, DWORD timeout) {
+    if (!set->count) {
+        Sleep(timeout);
+        return WAIT_TIMEOUT;
+    }
+
+    DWORD result = WaitForMultipleObjects(set->count, set->handles, FALSE, timeout);
+
+    if (result < WAIT_OBJECT_0 + set->count) {
+        return result - WAIT_OBJECT_0;
+    }
+    if (result >= WAIT_ABANDONED_0 && result < WAIT_ABANDONED_0 + set->count) {
+        return result - WAIT_ABANDONED_0;
+    }
+    return result == WAIT_TIMEOUT ? WAIT_TIMEOUT : WAIT_SLOT_STOP;    // WAIT_FAILED: stop
+}
+
+// Exported: queue work (safe from any thread)
+int capability_signal(void) {
+    return g_wait_set.count && SetEvent(g_wait_set.handles[WAIT_SLOT_WORK]);
+}
+
+// Exported: make capability_execute return at its next wait
+int capability_stop(void) {
+    return g_wait_set.count && SetEvent(g_wait_set.handles[WAIT_SLOT_STOP]);
+}
+
+// Wake capability_execute when handle is signaled. Auto-reset objects
+// only (see above). Add before execute starts; the handle must outlive
+// the loop.
+int capability_add_wait_handle(HANDLE handle) {
+    if (!g_wait_set.count || g_wait_set.count >= WAIT_MAX_HANDLES || !handle) return 0;
+    g_wait_set.handles[g_wait_set.count++] = handle;
+    return 1;
+}
+
 // ============================================================================
 // CAPABILITY FUNCTIONS
 // ============================================================================
 
 // Initialize capability
 int capability_init(void) {
-    // Parse configuration if available
-    if (_binary_config_bin_size >= sizeof(CONFIG)) {
-        my_memcpy(&g_config, _binary_config_bin_start, sizeof(CONFIG));
-    } else {
-        // Default configuration
-        g_config.sleep_time = 1000;
-        g_config.max_iterations = 10;
-        my_memcpy(g_config.target_process, "explorer.exe", 13);
+    // Header check only; fields are read in place as they are used, and a
+    // missing config falls back to the defaults in the accessors
+    config_open();
+
+    // Instance scratch memory (reserved only; pages commit on first use)
+    if (!arena_open(&g_arena, ARENA_RESERVE)) {
+        return 0;
     }
 
+    // Without the events execute falls back to Sleep polling
+    wait_set_open(&g_wait_set);
+
     return 1;  // Success
 }
 
@@ -88,17 +580,35 @@ int capability_init(void) {
 int capability_execute(void) {
     // Example: Simple beacon-like behavior
 
-    for (DWORD i = 0; i < g_config.max_iterations; i++) {
-        // Perform capability action
-        // (In real capability: check tasks, execute, report back)
-
-        // Sleep between iterations
-        Sleep(g_config.sleep_time);
+    DWORD max_iterations = config_max_iterations();
+    DWORD sleep_time = config_sleep_time();
 
-        // Simple counter check
-        if (i >= g_config.max_iterations - 1) {
+    for (DWORD i = 0; i < max_iterations; i++) {
+        // Wake on work, on a caller's handle, or after sleep_time at most
+        DWORD slot = wait_set_wait(&g_wait_set, sleep_time);
+        if (slot == WAIT_SLOT_STOP) {
             break;
         }
+
+        // Nothing signaled: timed check-in only, the task body is skipped
+        // (In real capability: heartbeat / poll for tasks here)
+        if (slot == WAIT_TIMEOUT) {
+            continue;
+        }
+
+        // Per-task scratch comes from the arena and goes back at the end
+        // of the iteration
+        SIZE_T mark = arena_mark(&g_arena);
+        BYTE* task = (BYTE*)arena_alloc(&g_arena, 16 * 1024);
+
+        // Perform capability action
+        // (In real capability: fetch the task for slot - WAIT_SLOT_WORK or
+        // an extra handle - execute, report back)
+        if (task) {
+            // Receive / decode / run into task...
+        }
+
+        arena_release(&g_arena, mark);
     }
 
     return 1;  // Success
@@ -107,8 +617,15 @@ int capability_execute(void) {
 // Cleanup capability
 int capability_cleanup(void) {
     // Clean up any resources
-    // Zero out configuration
-    my_memcpy(&g_config, "\x00", sizeof(CONFIG));
+    // Wipe the landed (unmasked) config copies and the config view; the
+    // appended resource itself is left as it was
+    my_secure_zero(g_config_landing, g_config_view.landing_used);
+    my_secure_zero(&g_config_view, sizeof(g_config_view));
+
+    // Wipe and release the arena (use arena_reset to keep it for reuse)
+    arena_close(&g_arena);
+
+    wait_set_close(&g_wait_set);
 
     return 1;  // Success
 }
@@ -119,61 +636,132 @@ int capability_cleanup(void) {
 
 // Main entry point - executes full capability lifecycle
 void go(void) {
+    PROFILE_RESET();
+    PROFILE_MARK("entry");
+
     // Initialize
     if (!capability_init()) {
         return;  // Initialization failed
     }
+    PROFILE_MARK("init");
 
     // Execute capability
     capability_execute();
+    PROFILE_MARK("execute");
 
     // Cleanup
     capability_cleanup();
+    PROFILE_MARK("cleanup");
+
+    PROFILE_DUMP(OutputDebugStringA);
 }
 
 // ============================================================================
 // ADVANCED EXAMPLE: Process Enumeration PICO
 // ============================================================================
 
+// Streaming walk over a Toolhelp snapshot: one PROCESSENTRY32 of state
+// (~300 bytes) instead of a 66 KB table, and callers can stop at the
+// first hit.
 typedef struct {
-    DWORD process_count;
-    DWORD process_ids[256];
-    char process_names[256][MAX_PATH];
-} PROCESS_LIST;
-
-// Enumerate processes (simplified example)
-int enumerate_processes(PROCESS_LIST* list) {
-    // In real implementation:
-    // 1. Use CreateToolhelp32Snapshot
-    // 2. Walk process list
-    // 3. Collect PIDs and names
-    // 4. Store in list structure
-
-    // For now, just return success
-    list->process_count = 0;
-    return 1;
+    HANDLE snapshot;
+    BOOL started;
+    PROCESSENTRY32 entry;
+} PROCESS_ITERATOR;
+
+BOOL process_iter_open(PROCESS_ITERATOR* iter) {
+    iter->snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    iter->started = FALSE;
+    iter->entry.dwSize = sizeof(iter->entry);
+    return iter->snapshot != INVALID_HANDLE_VALUE;
+}
+
+// Next process, or NULL once the snapshot is exhausted
+const PROCESSENTRY32* process_iter_next(PROCESS_ITERATOR* iter) {
+    BOOL ok = iter->started
+        ? Process32Next(iter->snapshot, &iter->entry)
+        : Process32First(iter->snapshot, &iter->entry);
+
+    iter->started = TRUE;
+    return ok ? &iter->entry : NULL;
+}
+
+void process_iter_close(PROCESS_ITERATOR* iter) {
+    if (iter->snapshot != INVALID_HANDLE_VALUE) {
+        CloseHandle(iter->snapshot);
+        iter->snapshot = INVALID_HANDLE_VALUE;
+    }
+}
+
+// Callback form: return FALSE from the callback to stop the walk.
+// Returns the number of processes visited.
+typedef BOOL (*PROCESS_CALLBACK)(const PROCESSENTRY32* entry, void* context);
+
+DWORD enumerate_processes(PROCESS_CALLBACK callback, void* context) {
+    PROCESS_ITERATOR iter;
+    const PROCESSENTRY32* entry;
+    DWORD visited = 0;
+
+    if (!process_iter_open(&iter)) {
+        return 0;
+    }
+
+    while ((entry = process_iter_next(&iter)) != NULL) {
+        visited++;
+        if (!callback(entry, context)) break;
+    }
+
+    process_iter_close(&iter);
+    return visited;
+}
+
+// ROR13 and length in one pass; a mismatch on either skips my_strcmp
+static DWORD process_name_hash(const char* name, DWORD* length) {
+    DWORD hash = 0;
+    DWORD i = 0;
+
+    for (; name[i]; i++) {
+        hash = (hash >> 13) | (hash << (32 - 13));
+        hash += (DWORD)(unsigned char)name[i];
+    }
+
+    *length = i;
+    return hash;
 }
 
 // Find process by name
 DWORD find_process_by_name(const char* name) {
-    PROCESS_LIST list;
+    PROCESS_ITERATOR iter;
+    const PROCESSENTRY32* entry;
+    DWORD name_length;
+    DWORD name_hash = process_name_hash(name, &name_length);
+    DWORD pid = 0;
 
-    if (!enumerate_processes(&list)) {
+    if (!process_iter_open(&iter)) {
         return 0;
     }
 
-    for (DWORD i = 0; i < list.process_count; i++) {
-        if (my_strcmp(list.process_names[i], name) == 0) {
-            return list.process_ids[i];
+    while ((entry = process_iter_next(&iter)) != NULL) {
+        DWORD length;
+        if (process_name_hash(entry->szExeFile, &length) != name_hash || length != name_length) {
+            continue;
+        }
+
+        if (my_strcmp(entry->szExeFile, name) == 0) {
+            pid = entry->th32ProcessID;
+            break;
         }
     }
 
-    return 0;  // Not found
+    process_iter_close(&iter);
+    my_secure_zero(&iter.entry, sizeof(iter.entry));
+
+    return pid;  // 0 if not found
 }
 
 // Alternate entry point for process enumeration PICO
 void go_enumerate(void) {
-    DWORD target_pid = find_process_by_name(g_config.target_process);
+    DWORD target_pid = find_process_by_name(config_target_process());
 
     if (target_pid) {
         // Found target process
@@ -201,6 +789,8 @@ void go_enumerate(void) {
  * - PICOs support global variables (unlike PIC shared libs)
  * - Each PICO instance has its own .bss
  * - Use fixbss if needed for globals
+ * - Take scratch buffers from g_arena (arena_alloc) rather than large
+ *   stack arrays or globals
  *
  * Size Optimization:
  * - Use +optimize to remove unused code
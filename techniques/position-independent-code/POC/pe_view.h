@@ -0,0 +1,183 @@
+/*
+ * Parsed Module View
+ *
+ * One validated view of a loaded image's headers, shared by the resolver
+ * (exports), the gadget scanner (sections, .text) and the PIC helpers:
+ *
+ *   PE_VIEW view;
+ *   if (pe_view_init(&view, hModule)) {
+ *       // view.exports, view.names, view.text_start, ...
+ *   }
+ *
+ * pe_view_init checks the DOS/NT signatures, and that the section table,
+ * export directory and export arrays lie inside SizeOfImage, once, so
+ * callers can index them without re-checking headers.
+ *
+ * Code that may keep globals can define PE_VIEW_CACHE_SIZE before
+ * including this header to get pe_view_get(), which parses each HMODULE
+ * once and copies the stored view out afterwards. PIC without .bss uses
+ * pe_view_init on a stack view instead.
+ */
+
+#ifndef PE_VIEW_H
+#define PE_VIEW_H
+
+// e_lfanew beyond this is treated as corrupt
+#define PE_VIEW_MAX_LFANEW 0x1000
+
+typedef struct {
+    BYTE* base;
+    PIMAGE_NT_HEADERS nt;
+    DWORD image_size;
+
+    PIMAGE_SECTION_HEADER sections;
+    WORD section_count;
+
+    BYTE* text_start;               // NULL if the image has no .text
+    SIZE_T text_size;
+
+    PIMAGE_EXPORT_DIRECTORY exports; // NULL if the image exports nothing
+    DWORD export_rva;
+    DWORD export_size;
+    DWORD* names;
+    DWORD* functions;
+    WORD* ordinals;
+} PE_VIEW;
+
+// [rva, rva + size) lies inside the image
+static inline BOOL pe_view_contains(const PE_VIEW* view, DWORD rva, SIZE_T size) {
+    return rva <= view->image_size && size <= view->image_size - rva;
+}
+
+// Export RVAs inside the export directory are forwarder strings
+static inline BOOL pe_view_is_forwarder(const PE_VIEW* view, DWORD rva) {
+    return rva >= view->export_rva && rva - view->export_rva < view->export_size;
+}
+
+static inline BOOL pe_view_init(PE_VIEW* view, HMODULE hModule) {
+    BYTE* base = (BYTE*)hModule;
+
+    for (SIZE_T i = 0; i < sizeof(*view); i++) {
+        ((BYTE*)view)[i] = 0;
+    }
+
+    if (!base) return FALSE;
+
+    PIMAGE_DOS_HEADER dos_header = (PIMAGE_DOS_HEADER)base;
+    if (dos_header->e_magic != IMAGE_DOS_SIGNATURE) return FALSE;
+    if (dos_header->e_lfanew <= 0 || dos_header->e_lfanew > PE_VIEW_MAX_LFANEW) return FALSE;
+
+    PIMAGE_NT_HEADERS nt_headers = (PIMAGE_NT_HEADERS)(base + dos_header->e_lfanew);
+    if (nt_headers->Signature != IMAGE_NT_SIGNATURE) return FALSE;
+    if (nt_headers->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR_MAGIC) return FALSE;
+
+    view->base = base;
+    view->nt = nt_headers;
+    view->image_size = nt_headers->OptionalHeader.SizeOfImage;
+
+    // Section table
+    PIMAGE_SECTION_HEADER sections = IMAGE_FIRST_SECTION(nt_headers);
+    WORD section_count = nt_headers->FileHeader.NumberOfSections;
+
+    if (!pe_view_contains(view, (DWORD)((BYTE*)sections - base),
+                          section_count * sizeof(IMAGE_SECTION_HEADER))) {
+        return FALSE;
+    }
+
+    view->sections = sections;
+    view->section_count = section_count;
+
+    for (WORD i = 0; i < section_count; i++) {
+        PIMAGE_SECTION_HEADER section = &sections[i];
+        const char* text = ".text";
+        BOOL is_text = TRUE;
+
+        for (int c = 0; c < 6; c++) {
+            if (section->Name[c] != (BYTE)text[c]) {
+                is_text = FALSE;
+                break;
+            }
+        }
+
+        if (is_text && pe_view_contains(view, section->VirtualAddress, section->Misc.VirtualSize)) {
+            view->text_start = base + section->VirtualAddress;
+            view->text_size = section->Misc.VirtualSize;
+            break;
+        }
+    }
+
+    // Export directory and its three arrays
+    if (nt_headers->OptionalHeader.NumberOfRvaAndSizes > IMAGE_DIRECTORY_ENTRY_EXPORT) {
+        IMAGE_DATA_DIRECTORY* export_data =
+            &nt_headers->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+
+        if (export_data->VirtualAddress &&
+            export_data->Size >= sizeof(IMAGE_EXPORT_DIRECTORY) &&
+            pe_view_contains(view, export_data->VirtualAddress, export_data->Size)) {
+            PIMAGE_EXPORT_DIRECTORY exports =
+                (PIMAGE_EXPORT_DIRECTORY)(base + export_data->VirtualAddress);
+
+            if (pe_view_contains(view, exports->AddressOfNames, exports->NumberOfNames * sizeof(DWORD)) &&
+                pe_view_contains(view, exports->AddressOfNameOrdinals, exports->NumberOfNames * sizeof(WORD)) &&
+                pe_view_contains(view, exports->AddressOfFunctions, exports->NumberOfFunctions * sizeof(DWORD))) {
+                view->exports = exports;
+                view->export_rva = export_data->VirtualAddress;
+                view->export_size = export_data->Size;
+                view->names = (DWORD*)(base + exports->AddressOfNames);
+                view->functions = (DWORD*)(base + exports->AddressOfFunctions);
+                view->ordinals = (WORD*)(base + exports->AddressOfNameOrdinals);
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+#ifdef PE_VIEW_CACHE_SIZE
+
+static PE_VIEW g_pe_views[PE_VIEW_CACHE_SIZE];
+static DWORD g_pe_view_count = 0;
+static DWORD g_pe_view_next = 0;
+
+// Parsed once per HMODULE, then copied out of the cache. Copying keeps the
+// caller's view valid even if a nested lookup (forwarder chasing) recycles
+// the slot.
+static inline BOOL pe_view_get(PE_VIEW* view, HMODULE hModule) {
+    for (DWORD i = 0; i < g_pe_view_count; i++) {
+        if (g_pe_views[i].base == (BYTE*)hModule) {
+            *view = g_pe_views[i];
+            return TRUE;
+        }
+    }
+
+    if (!pe_view_init(view, hModule)) return FALSE;
+
+    // Full: recycle round-robin
+    DWORD slot = g_pe_view_count < PE_VIEW_CACHE_SIZE
+        ? g_pe_view_count++
+        : g_pe_view_next++ % PE_VIEW_CACHE_SIZE;
+
+    g_pe_views[slot] = *view;
+    return TRUE;
+}
+
+// Drop cached views (a freed base may be reused by another image)
+static inline void pe_view_cache_reset(void) {
+    g_pe_view_count = 0;
+    g_pe_view_next = 0;
+}
+
+// Drop one module's view (unload), keeping the rest
+static inline void pe_view_cache_drop(HMODULE hModule) {
+    for (DWORD i = 0; i < g_pe_view_count; i++) {
+        if (g_pe_views[i].base == (BYTE*)hModule) {
+            g_pe_views[i] = g_pe_views[--g_pe_view_count];
+            g_pe_view_next = 0;
+            return;
+        }
+    }
+}
+
+#endif // PE_VIEW_CACHE_SIZE
+
+#endif // PE_VIEW_H
@@ -4,17 +4,24 @@
  * This demonstrates basic position-independent code that displays a message box
  * using manual API resolution via hash-based DFR.
  *
- * Compile:
- *   x86_64-w64-mingw32-gcc -c simple_pic_messagebox.c -o simple_pic_messagebox.x64.o
+ * Compile (-Os folds the ROR13() hashes to immediates):
+ *   x86_64-w64-mingw32-gcc -Os -c simple_pic_messagebox.c -o simple_pic_messagebox.x64.o
  *
  * Use with Crystal Palace:
  *   load "simple_pic_messagebox.x64.o"
  *     dfr "resolve" "ror13"
  *     make pic +optimize
  *   link "messagebox.bin"
+ *
+ * Startup profiling (see tradecraft-debugging/POC/phase_profile.h): add
+ * -DPIC_PROFILE and fixbss "_bss_fix" before make pic. Phase timings go to
+ * OutputDebugStringA once the message box is shown.
  */
 
 #include <windows.h>
+#include "../../dynamic-function-resolution/POC/ror13_hash.h"
+#include "pe_view.h"
+#include "../../tradecraft-debugging/POC/phase_profile.h"
 
 // ROR13 hash algorithm
 DWORD ror13_hash(const char* str) {
@@ -27,15 +34,34 @@ DWORD ror13_hash(const char* str) {
     return hash;
 }
 
-// Pre-computed hashes
-#define HASH_KERNEL32           0x6A4ABC5B
-#define HASH_USER32             0x74FA1C3E
-#define HASH_LOADLIBRARYA       0xEC0E4E8E
-#define HASH_GETPROCADDRESS     0x7C0DFCAA
-#define HASH_MESSAGEBOXA        0xBC4DA2A8
+// Hashes folded at compile time
+#define HASH_KERNEL32           ROR13_MODULE("kernel32.dll")
+#define HASH_USER32             ROR13_MODULE("user32.dll")
+#define HASH_NTDLL              ROR13_MODULE("ntdll.dll")
+#define HASH_LOADLIBRARYA       ROR13("LoadLibraryA")
+#define HASH_MESSAGEBOXA        ROR13("MessageBoxA")
+#define HASH_OUTPUTDEBUGSTRINGA ROR13("OutputDebugStringA")
 
-// Get kernel32 base from PEB
-HMODULE get_kernel32(void) {
+// Unicode ROR13 over BaseDllName (uppercased, matches ROR13_MODULE)
+DWORD unicode_ror13_hash(PUNICODE_STRING str) {
+    DWORD hash = 0;
+
+    for (int i = 0; i < str->Length / sizeof(WCHAR); i++) {
+        WCHAR c = str->Buffer[i];
+        if (c >= 'a' && c <= 'z') {
+            c -= 0x20;
+        }
+
+        hash = (hash >> 13) | (hash << (32 - 13));
+        hash += (DWORD)c;
+    }
+
+    return hash;
+}
+
+// Find a loaded module by name hash. PIC has no globals to cache the
+// result in, so callers should look up each module once and keep it.
+HMODULE get_module_by_hash(DWORD module_hash) {
     #ifdef _WIN64
     PPEB pPeb = (PPEB)__readgsqword(0x60);
     #else
@@ -43,76 +69,168 @@ HMODULE get_kernel32(void) {
     #endif
 
     PLIST_ENTRY pListHead = &pPeb->Ldr->InMemoryOrderModuleList;
-    PLIST_ENTRY pListEntry = pListHead->Flink;
-
-    // Second entry is usually kernel32
-    pListEntry = pListEntry->Flink;
-    PLDR_DATA_TABLE_ENTRY pEntry = CONTAINING_RECORD(
-        pListEntry,
-        LDR_DATA_TABLE_ENTRY,
-        InMemoryOrderLinks
-    );
 
-    return (HMODULE)pEntry->DllBase;
+    for (PLIST_ENTRY pListEntry = pListHead->Flink; pListEntry != pListHead;
+         pListEntry = pListEntry->Flink) {
+        PLDR_DATA_TABLE_ENTRY pEntry = CONTAINING_RECORD(
+            pListEntry,
+            LDR_DATA_TABLE_ENTRY,
+            InMemoryOrderLinks
+        );
+
+        if (unicode_ror13_hash(&pEntry->BaseDllName) == module_hash) {
+            return (HMODULE)pEntry->DllBase;
+        }
+    }
+
+    return NULL;
 }
 
-// Resolve function by hash
-FARPROC resolve_by_hash(HMODULE hModule, DWORD function_hash) {
-    PIMAGE_DOS_HEADER pDosHeader = (PIMAGE_DOS_HEADER)hModule;
-    PIMAGE_NT_HEADERS pNtHeaders = (PIMAGE_NT_HEADERS)(
-        (BYTE*)hModule + pDosHeader->e_lfanew
-    );
+// Get kernel32 base from PEB. Matched by name: its position in the list
+// (usually third, after the image and ntdll) is not guaranteed.
+HMODULE get_kernel32(void) {
+    return get_module_by_hash(HASH_KERNEL32);
+}
 
-    DWORD export_rva = pNtHeaders->OptionalHeader.DataDirectory[
-        IMAGE_DIRECTORY_ENTRY_EXPORT
-    ].VirtualAddress;
+#define MAX_FORWARD_DEPTH 4
 
-    PIMAGE_EXPORT_DIRECTORY pExportDir = (PIMAGE_EXPORT_DIRECTORY)(
-        (BYTE*)hModule + export_rva
-    );
+FARPROC resolve_export(HMODULE hModule, DWORD function_hash, DWORD depth);
+
+// Chase a forwarder string "MODULE.Function" (e.g. "NTDLL.RtlAllocateHeap")
+// to its target module instead of returning a pointer to the string.
+// Ordinal and API set forwarders are not handled here.
+FARPROC resolve_forwarder(const char* forwarder, DWORD depth) {
+    const char* dot = NULL;
+    for (const char* p = forwarder; *p; p++) {
+        if (*p == '.') dot = p;
+    }
+
+    if (!dot || dot[1] == '#' || depth >= MAX_FORWARD_DEPTH) return NULL;
 
-    DWORD* pNames = (DWORD*)((BYTE*)hModule + pExportDir->AddressOfNames);
-    DWORD* pFunctions = (DWORD*)((BYTE*)hModule + pExportDir->AddressOfFunctions);
-    WORD* pOrdinals = (WORD*)((BYTE*)hModule + pExportDir->AddressOfNameOrdinals);
+    // Hash "MODULE" + ".DLL" the way BaseDllName is hashed
+    DWORD module_hash = 0;
+    for (const char* p = forwarder; p < dot; p++) {
+        char c = *p;
+        if (c >= 'a' && c <= 'z') c -= 0x20;
+        module_hash = (module_hash >> 13) | (module_hash << (32 - 13));
+        module_hash += (DWORD)c;
+    }
+    for (const char* p = ".DLL"; *p; p++) {
+        module_hash = (module_hash >> 13) | (module_hash << (32 - 13));
+        module_hash += (DWORD)*p;
+    }
 
-    for (DWORD i = 0; i < pExportDir->NumberOfNames; i++) {
-        char* funcName = (char*)((BYTE*)hModule + pNames[i]);
+    HMODULE hTarget = get_module_by_hash(module_hash);
+    if (!hTarget) return NULL;
+
+    return resolve_export(hTarget, ror13_hash(dot + 1), depth + 1);
+}
+
+FARPROC resolve_export(HMODULE hModule, DWORD function_hash, DWORD depth) {
+    PE_VIEW view;
+    if (!pe_view_init(&view, hModule) || !view.exports) return NULL;
+
+    for (DWORD i = 0; i < view.exports->NumberOfNames; i++) {
+        char* funcName = (char*)(view.base + view.names[i]);
         DWORD hash = ror13_hash(funcName);
 
         if (hash == function_hash) {
-            return (FARPROC)((BYTE*)hModule + pFunctions[pOrdinals[i]]);
+            WORD ordinal = view.ordinals[i];
+            if (ordinal >= view.exports->NumberOfFunctions) return NULL;
+
+            DWORD rva = view.functions[ordinal];
+            if (!rva || !pe_view_contains(&view, rva, 1)) return NULL;
+
+            if (pe_view_is_forwarder(&view, rva)) {
+                return resolve_forwarder((char*)view.base + rva, depth);
+            }
+
+            return (FARPROC)(view.base + rva);
         }
     }
 
     return NULL;
 }
 
+// Resolve function by hash
+FARPROC resolve_by_hash(HMODULE hModule, DWORD function_hash) {
+    return resolve_export(hModule, function_hash, 0);
+}
+
+#ifdef PIC_PROFILE
+// fixbss hook: the profile ring is this PIC's only .bss. It lives in the
+// zero-filled tail of the last page of ntdll's .data, past VirtualSize,
+// which nothing else maps data into. Only .data: other writable sections
+// (.mrdata) are made read-only after loader init. Without enough slack
+// this returns NULL and profiling stays off. The scan is deterministic,
+// so every call returns the same address.
+void* _bss_fix(void) {
+    PE_VIEW view;
+    if (!pe_view_init(&view, get_module_by_hash(HASH_NTDLL))) return NULL;
+
+    DWORD alignment = view.nt->OptionalHeader.SectionAlignment;
+
+    for (WORD i = 0; i < view.section_count; i++) {
+        PIMAGE_SECTION_HEADER section = &view.sections[i];
+        if (!(section->Characteristics & IMAGE_SCN_MEM_WRITE)) continue;
+
+        // Exactly ".data" (NUL included, so ".data1" etc. don't match)
+        const char* data = ".data";
+        BOOL is_data = TRUE;
+        for (int c = 0; c < 6; c++) {
+            if (section->Name[c] != (BYTE)data[c]) {
+                is_data = FALSE;
+                break;
+            }
+        }
+        if (!is_data) continue;
+
+        DWORD end = section->VirtualAddress + section->Misc.VirtualSize;
+        DWORD mapped_end = (end + alignment - 1) & ~(alignment - 1);
+
+        // The ring starts at the 16-byte aligned end, so count the padding
+        DWORD aligned = (end + 15) & ~15u;
+
+        if (aligned <= mapped_end && mapped_end - aligned >= sizeof(PROFILE_RING)) {
+            return view.base + aligned;
+        }
+        break;
+    }
+
+    return NULL;
+}
+#endif
+
 // Entry point
 void go(void) {
-    // Get kernel32
-    HMODULE hKernel32 = get_kernel32();
+    PROFILE_RESET();
+    PROFILE_MARK("entry");
 
-    // Resolve LoadLibraryA and GetProcAddress
-    typedef HMODULE (WINAPI *pLoadLibraryA)(LPCSTR);
-    typedef FARPROC (WINAPI *pGetProcAddress)(HMODULE, LPCSTR);
+    // User32 is often already loaded; only fall back to LoadLibraryA if not
+    HMODULE hUser32 = get_module_by_hash(HASH_USER32);
+    PROFILE_MARK("peb_walk");
 
-    pLoadLibraryA LoadLibraryA = (pLoadLibraryA)resolve_by_hash(
-        hKernel32, HASH_LOADLIBRARYA
-    );
+    if (!hUser32) {
+        typedef HMODULE (WINAPI *pLoadLibraryA)(LPCSTR);
 
-    pGetProcAddress GetProcAddress = (pGetProcAddress)resolve_by_hash(
-        hKernel32, HASH_GETPROCADDRESS
-    );
+        pLoadLibraryA LoadLibraryA = (pLoadLibraryA)resolve_by_hash(
+            get_kernel32(), HASH_LOADLIBRARYA
+        );
 
-    // Load user32.dll
-    HMODULE hUser32 = LoadLibraryA("user32.dll");
+        hUser32 = LoadLibraryA("user32.dll");
+        PROFILE_MARK("load_library");
+    }
 
     // Resolve MessageBoxA
     typedef int (WINAPI *pMessageBoxA)(HWND, LPCSTR, LPCSTR, UINT);
     pMessageBoxA MessageBoxA = (pMessageBoxA)resolve_by_hash(
         hUser32, HASH_MESSAGEBOXA
     );
+    PROFILE_MARK("resolve");
 
     // Display message
     MessageBoxA(NULL, "Hello from PIC!", "Tradecraft Garden", MB_OK);
+    PROFILE_MARK("first_work");
+
+    PROFILE_DUMP(resolve_by_hash(get_kernel32(), HASH_OUTPUTDEBUGSTRINGA));
 }
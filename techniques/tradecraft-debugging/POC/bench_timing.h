@@ -0,0 +1,72 @@
+/*
+ * Benchmark Timing
+ *
+ * Shared by the host benchmark tools (microbench.c, pic_runner.c):
+ * lfence-fenced rdtsc, scaled to ns against QPC, and percentile
+ * summaries of per-sample cycle counts.
+ */
+
+#ifndef BENCH_TIMING_H
+#define BENCH_TIMING_H
+
+#include <stdlib.h>
+#include <x86intrin.h>
+
+// Samples discarded before recording
+#define BENCH_WARMUP 16
+
+typedef struct {
+    double min_ns;
+    double p50_ns;
+    double p90_ns;
+    double p99_ns;
+    double p50_cycles;
+} BENCH_RESULT;
+
+static double g_ns_per_cycle;
+
+static inline unsigned long long bench_ticks(void) {
+    _mm_lfence();
+    unsigned long long t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+// rdtsc is invariant on anything we run on; scale it against QPC once
+static void bench_calibrate(void) {
+    LARGE_INTEGER freq, start, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
+
+    unsigned long long t0 = bench_ticks();
+    do {
+        QueryPerformanceCounter(&now);
+    } while ((now.QuadPart - start.QuadPart) * 20 < freq.QuadPart);   // 50 ms
+    unsigned long long t1 = bench_ticks();
+
+    double ns = (double)(now.QuadPart - start.QuadPart) * 1e9 / (double)freq.QuadPart;
+    g_ns_per_cycle = ns / (double)(t1 - t0);
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double* sorted, DWORD count, double p) {
+    DWORD index = (DWORD)(p * (count - 1) + 0.5);
+    return sorted[index];
+}
+
+// Sorts cycles (per-operation cycle counts) in place
+static void bench_summarize(double* cycles, DWORD count, BENCH_RESULT* result) {
+    qsort(cycles, count, sizeof(double), compare_doubles);
+
+    result->min_ns = cycles[0] * g_ns_per_cycle;
+    result->p50_ns = percentile(cycles, count, 0.50) * g_ns_per_cycle;
+    result->p90_ns = percentile(cycles, count, 0.90) * g_ns_per_cycle;
+    result->p99_ns = percentile(cycles, count, 0.99) * g_ns_per_cycle;
+    result->p50_cycles = percentile(cycles, count, 0.50);
+}
+
+#endif // BENCH_TIMING_H
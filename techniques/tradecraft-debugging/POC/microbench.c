@@ -0,0 +1,295 @@
+/*
+ * Tradecraft Microbenchmarks
+ *
+ * Times the hot primitives of the POCs on the host:
+ *
+ *   resolver  - ror13_hash, wfnv_hash, find_module_by_hash, find_function_by_hash
+ *               (cold/warm), resolve_cached (miss/hit)
+ *   scanner   - find_call_r10_gadget and find_call_r10_gadgets per module
+ *   PICO      - my_memcpy, my_strlen, my_strcmp, my_secure_zero,
+ *               arena_alloc (mark/alloc/release scope)
+ *
+ * Each sample times a fixed number of operations with rdtsc (converted
+ * to ns against QPC); warmup samples are discarded and the rest reported
+ * as min/p50/p90/p99. "cold" drops the resolver's caches before every
+ * operation, outside the timed region.
+ *
+ * Output is a table, or CSV with --csv for tracking across changes:
+ *   benchmark,ops_per_sample,samples,min_ns,p50_ns,p90_ns,p99_ns,p50_cycles
+ *
+ * Compile (host tool, not PIC):
+ *   x86_64-w64-mingw32-gcc -O2 microbench.c -o microbench.exe
+ */
+
+// The POCs are compiled in directly; their entry points are renamed so
+// they can share one executable.
+#define RESOLVER_NO_EXAMPLES
+#include "../../dynamic-function-resolution/POC/ror13_resolver.c"
+
+#define go gadget_loader_go
+#define example_usage gadget_loader_example_usage
+#include "../../edr-evasion/call-stack-spoofing/POC/gadget_loader.c"
+#undef go
+#undef example_usage
+
+#define go pico_go
+#include "../../pico/POC/simple_pico_capability.c"
+#undef go
+
+#include <stdio.h>
+#include <string.h>
+#include "bench_timing.h"
+
+// The PICO's appended config (none here)
+unsigned char _binary_config_bin_start[1];
+unsigned int  _binary_config_bin_size = 0;
+
+typedef void (*BENCH_FN)(void* context);
+
+typedef struct {
+    char name[64];
+    BENCH_FN run;               // One operation
+    BENCH_FN reset;             // Before every operation, untimed (NULL = none)
+    void* context;
+    DWORD ops;                  // Operations per sample (1 if reset is set)
+    DWORD samples;
+} BENCH;
+
+static volatile ULONG_PTR g_bench_sink;
+
+// ============================================================================
+// TIMING
+// ============================================================================
+
+static BOOL bench_run(const BENCH* bench, BENCH_RESULT* result) {
+    DWORD ops = bench->reset ? 1 : bench->ops;
+    double* cycles = (double*)malloc(bench->samples * sizeof(double));
+    if (!cycles) return FALSE;
+
+    for (DWORD s = 0; s < BENCH_WARMUP + bench->samples; s++) {
+        if (bench->reset) bench->reset(bench->context);
+
+        unsigned long long start = bench_ticks();
+        for (DWORD i = 0; i < ops; i++) {
+            bench->run(bench->context);
+        }
+        unsigned long long end = bench_ticks();
+
+        if (s >= BENCH_WARMUP) {
+            cycles[s - BENCH_WARMUP] = (double)(end - start) / ops;
+        }
+    }
+
+    bench_summarize(cycles, bench->samples, result);
+
+    free(cycles);
+    return TRUE;
+}
+
+// ============================================================================
+// RESOLVER
+// ============================================================================
+
+typedef struct {
+    HMODULE module;
+    DWORD module_hash;
+    DWORD function_hash;
+    const char* name;
+} RESOLVER_TARGET;
+
+static void bench_ror13_hash(void* context) {
+    g_bench_sink += ror13_hash(((RESOLVER_TARGET*)context)->name);
+}
+
+static void bench_wfnv_hash(void* context) {
+    g_bench_sink += wfnv_hash(((RESOLVER_TARGET*)context)->name);
+}
+
+static void bench_find_module(void* context) {
+    g_bench_sink += (ULONG_PTR)find_module_by_hash(((RESOLVER_TARGET*)context)->module_hash);
+}
+
+static void bench_find_module_uncached(void* context) {
+    g_bench_sink += (ULONG_PTR)find_module_by_hash_uncached(((RESOLVER_TARGET*)context)->module_hash);
+}
+
+static void bench_find_function(void* context) {
+    RESOLVER_TARGET* target = (RESOLVER_TARGET*)context;
+    g_bench_sink += (ULONG_PTR)find_function_by_hash(target->module, target->function_hash);
+}
+
+static void bench_resolve_cached(void* context) {
+    RESOLVER_TARGET* target = (RESOLVER_TARGET*)context;
+    g_bench_sink += (ULONG_PTR)resolve_cached(target->module_hash, target->function_hash);
+}
+
+// Parsed views and cached modules are dropped; the export walk starts cold
+static void reset_resolver_caches(void* context) {
+    module_cache_invalidate();
+}
+
+static void reset_resolve_cache(void* context) {
+    resolve_cache_reset();
+    memset(&g_cache_stats, 0, sizeof(g_cache_stats));
+}
+
+// ============================================================================
+// SCANNER
+// ============================================================================
+
+static void bench_find_gadget(void* context) {
+    g_bench_sink += (ULONG_PTR)find_call_r10_gadget((HMODULE)context).address;
+}
+
+static void bench_find_gadgets(void* context) {
+    GADGET_MATCH matches[64];
+    g_bench_sink += find_call_r10_gadgets((HMODULE)context, matches, 64);
+}
+
+// ============================================================================
+// PICO HELPERS
+// ============================================================================
+
+typedef struct {
+    BYTE* a;
+    BYTE* b;
+    SIZE_T size;
+} BUFFER_PAIR;
+
+static void bench_memcpy(void* context) {
+    BUFFER_PAIR* pair = (BUFFER_PAIR*)context;
+    my_memcpy(pair->a, pair->b, pair->size);
+    g_bench_sink += pair->a[0];
+}
+
+static void bench_strlen(void* context) {
+    g_bench_sink += my_strlen((const char*)((BUFFER_PAIR*)context)->a);
+}
+
+static void bench_strcmp(void* context) {
+    BUFFER_PAIR* pair = (BUFFER_PAIR*)context;
+    g_bench_sink += my_strcmp((const char*)pair->a, (const char*)pair->b);
+}
+
+static void bench_secure_zero(void* context) {
+    BUFFER_PAIR* pair = (BUFFER_PAIR*)context;
+    my_secure_zero(pair->a, pair->size);
+}
+
+// One per-task scratch scope, as in capability_execute
+static void bench_arena_scope(void* context) {
+    PICO_ARENA* arena = (PICO_ARENA*)context;
+    SIZE_T mark = arena_mark(arena);
+    g_bench_sink += (ULONG_PTR)arena_alloc(arena, 16 * 1024);
+    arena_release(arena, mark);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+#define MAX_BENCHES 64
+
+static BENCH g_benches[MAX_BENCHES];
+static DWORD g_bench_count = 0;
+
+static void add_bench(const char* name, BENCH_FN run, BENCH_FN reset,
+                      void* context, DWORD ops, DWORD samples) {
+    if (g_bench_count >= MAX_BENCHES) return;
+
+    BENCH* bench = &g_benches[g_bench_count++];
+    snprintf(bench->name, sizeof(bench->name), "%s", name);
+    bench->run = run;
+    bench->reset = reset;
+    bench->context = context;
+    bench->ops = ops;
+    bench->samples = samples;
+}
+
+int main(int argc, char** argv) {
+    BOOL csv = argc > 1 && strcmp(argv[1], "--csv") == 0;
+
+    bench_calibrate();
+
+    // Resolver: VirtualAlloc in kernel32
+    static RESOLVER_TARGET target;
+    target.module = find_module_by_hash_uncached(HASH_KERNEL32);
+    target.module_hash = HASH_KERNEL32;
+    target.function_hash = HASH_VIRTUALALLOC;
+    target.name = "VirtualAlloc";
+
+    add_bench("ror13_hash/VirtualAlloc", bench_ror13_hash, NULL, &target, 1000, 1000);
+    add_bench("wfnv_hash/VirtualAlloc", bench_wfnv_hash, NULL, &target, 1000, 1000);
+    add_bench("find_module_by_hash/kernel32", bench_find_module, NULL, &target, 1000, 1000);
+    add_bench("find_module_by_hash_uncached/kernel32", bench_find_module_uncached, NULL, &target, 100, 1000);
+    add_bench("find_function_by_hash/cold", bench_find_function, reset_resolver_caches, &target, 1, 1000);
+    add_bench("find_function_by_hash/warm", bench_find_function, NULL, &target, 100, 1000);
+    add_bench("resolve_cached/miss", bench_resolve_cached, reset_resolve_cache, &target, 1, 1000);
+    add_bench("resolve_cached/hit", bench_resolve_cached, NULL, &target, 1000, 1000);
+
+    // Scanner: every probe module the loader would use
+    for (int i = 0; g_gadget_modules[i] != NULL; i++) {
+        HMODULE hMod = LoadLibraryA(g_gadget_modules[i]);
+        if (!hMod) continue;
+
+        char name[64];
+        snprintf(name, sizeof(name), "find_call_r10_gadget/%s", g_gadget_modules[i]);
+        add_bench(name, bench_find_gadget, NULL, hMod, 1, 50);
+        snprintf(name, sizeof(name), "find_call_r10_gadgets/%s", g_gadget_modules[i]);
+        add_bench(name, bench_find_gadgets, NULL, hMod, 1, 50);
+    }
+
+    // PICO helpers: config-sized copies, MAX_PATH-sized strings, a
+    // PROCESS_LIST-sized wipe
+    static BYTE copy_dst[4096 + 64], copy_src[4096 + 64];
+    static BYTE str_a[MAX_PATH], str_b[MAX_PATH];
+    static BYTE wipe[68 * 1024];
+
+    memset(copy_src, 0x41, sizeof(copy_src));
+    memset(str_a, 'a', MAX_PATH - 1);
+    memset(str_b, 'a', MAX_PATH - 1);
+
+    static BUFFER_PAIR copy_small = { copy_dst, copy_src, sizeof(CONFIG) };
+    static BUFFER_PAIR copy_page = { copy_dst + 1, copy_src + 3, 4096 };
+    static BUFFER_PAIR strings = { str_a, str_b, 0 };
+    static BUFFER_PAIR wipe_list = { wipe, NULL, sizeof(wipe) };
+
+    add_bench("my_memcpy/config", bench_memcpy, NULL, &copy_small, 1000, 1000);
+    add_bench("my_memcpy/4096_unaligned", bench_memcpy, NULL, &copy_page, 100, 1000);
+    add_bench("my_strlen/259", bench_strlen, NULL, &strings, 1000, 1000);
+    add_bench("my_strcmp/259_equal", bench_strcmp, NULL, &strings, 1000, 1000);
+    add_bench("my_secure_zero/68k", bench_secure_zero, NULL, &wipe_list, 10, 200);
+
+    static PICO_ARENA arena;
+    if (arena_open(&arena, ARENA_RESERVE)) {
+        add_bench("arena_alloc/16k_scope", bench_arena_scope, NULL, &arena, 1000, 1000);
+    }
+
+    if (csv) {
+        printf("benchmark,ops_per_sample,samples,min_ns,p50_ns,p90_ns,p99_ns,p50_cycles\n");
+    } else {
+        printf("%-40s %10s %10s %10s %10s %10s\n",
+               "benchmark", "min ns", "p50 ns", "p90 ns", "p99 ns", "p50 cyc");
+    }
+
+    for (DWORD i = 0; i < g_bench_count; i++) {
+        BENCH* bench = &g_benches[i];
+        BENCH_RESULT result;
+
+        if (!bench_run(bench, &result)) continue;
+
+        if (csv) {
+            printf("%s,%lu,%lu,%.1f,%.1f,%.1f,%.1f,%.0f\n",
+                   bench->name, bench->reset ? 1UL : (unsigned long)bench->ops,
+                   (unsigned long)bench->samples,
+                   result.min_ns, result.p50_ns, result.p90_ns, result.p99_ns,
+                   result.p50_cycles);
+        } else {
+            printf("%-40s %10.1f %10.1f %10.1f %10.1f %10.0f\n",
+                   bench->name, result.min_ns, result.p50_ns, result.p90_ns,
+                   result.p99_ns, result.p50_cycles);
+        }
+    }
+
+    return 0;
+}
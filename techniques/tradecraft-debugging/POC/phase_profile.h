@@ -0,0 +1,137 @@
+/*
+ * Startup Phase Profiler
+ *
+ * Opt-in rdtsc timestamps at named phases of a PIC/PICO go() path:
+ *
+ *   PROFILE_MARK("entry");
+ *   ...PEB walk...
+ *   PROFILE_MARK("peb_walk");
+ *   ...
+ *   PROFILE_DUMP(output);      // void WINAPI output(LPCSTR), e.g. OutputDebugStringA
+ *
+ * Build with -DPIC_PROFILE to enable. Without it every macro expands to
+ * nothing and its arguments are not evaluated, so the profiler adds no
+ * code, data or cycles.
+ *
+ * Marks go to a fixed ring in .bss (last PROFILE_RING_SIZE kept). PICOs
+ * have their own .bss; PIC needs fixbss in the spec (a _bss_fix that
+ * returns NULL turns every macro into a no-op):
+ *
+ *   load "simple_pic_messagebox.x64.o"
+ *     dfr "resolve" "ror13"
+ *     fixbss "_bss_fix"
+ *     make pic
+ *
+ * Dump lines are "[profile] <phase> +<cycles since previous> <cycles since first>".
+ */
+
+#ifndef PHASE_PROFILE_H
+#define PHASE_PROFILE_H
+
+#ifdef PIC_PROFILE
+
+#define PROFILE_RING_SIZE 32
+
+typedef struct {
+    const char* phase;
+    DWORD64 tsc;
+} PROFILE_ENTRY;
+
+typedef struct {
+    DWORD count;                        // Marks recorded (may exceed the ring)
+    PROFILE_ENTRY entries[PROFILE_RING_SIZE];
+} PROFILE_RING;
+
+typedef void (WINAPI *PROFILE_OUTPUT)(LPCSTR);
+
+static PROFILE_RING g_profile_ring;
+
+// Under fixbss &g_profile_ring is _bss_fix()'s result, which may be NULL.
+// The empty asm hides the address from the compiler, which would
+// otherwise fold the NULL check away.
+static inline PROFILE_RING* profile_ring(void) {
+    PROFILE_RING* ring = &g_profile_ring;
+    __asm__("" : "+r"(ring));
+    return ring;
+}
+
+static inline DWORD64 profile_ticks(void) {
+    DWORD lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((DWORD64)hi << 32) | lo;
+}
+
+static void profile_mark(const char* phase) {
+    PROFILE_RING* ring = profile_ring();
+    if (!ring) return;
+
+    PROFILE_ENTRY* entry = &ring->entries[ring->count % PROFILE_RING_SIZE];
+    entry->phase = phase;
+    entry->tsc = profile_ticks();
+    ring->count++;
+}
+
+static void profile_reset(void) {
+    PROFILE_RING* ring = profile_ring();
+    if (ring) ring->count = 0;
+}
+
+// Decimal into out, returns the new end
+static char* profile_format_u64(char* out, DWORD64 value) {
+    char digits[20];
+    int n = 0;
+
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    while (n) *out++ = digits[--n];
+    return out;
+}
+
+static void profile_dump(PROFILE_OUTPUT output) {
+    PROFILE_RING* ring = profile_ring();
+    if (!output || !ring) return;
+
+    DWORD count = ring->count;
+    DWORD first = count > PROFILE_RING_SIZE ? count - PROFILE_RING_SIZE : 0;
+
+    if (count == 0) return;
+
+    DWORD64 start = ring->entries[first % PROFILE_RING_SIZE].tsc;
+    DWORD64 previous = start;
+
+    for (DWORD i = first; i < count; i++) {
+        PROFILE_ENTRY* entry = &ring->entries[i % PROFILE_RING_SIZE];
+        char line[96];
+        char* p = line;
+
+        for (const char* s = "[profile] "; *s; s++) *p++ = *s;
+        for (const char* s = entry->phase; *s && p < line + 40; s++) *p++ = *s;
+        *p++ = ' ';
+        *p++ = '+';
+        p = profile_format_u64(p, entry->tsc - previous);
+        *p++ = ' ';
+        p = profile_format_u64(p, entry->tsc - start);
+        *p++ = '\n';
+        *p = 0;
+
+        output(line);
+        previous = entry->tsc;
+    }
+}
+
+#define PROFILE_MARK(phase)     profile_mark(phase)
+#define PROFILE_DUMP(output)    profile_dump((PROFILE_OUTPUT)(output))
+#define PROFILE_RESET()         profile_reset()
+
+#else
+
+#define PROFILE_MARK(phase)     ((void)0)
+#define PROFILE_DUMP(output)    ((void)0)
+#define PROFILE_RESET()         ((void)0)
+
+#endif // PIC_PROFILE
+
+#endif // PHASE_PROFILE_H
@@ -0,0 +1,133 @@
+/*
+ * PIC Runner
+ *
+ * Maps a linked PIC blob and times its entry point (offset 0, so link
+ * with +gofirst) with the microbenchmark timer:
+ *
+ *   pic_runner.exe capability.x64.bin [samples] [--csv]
+ *
+ * The blob is copied to fresh RW memory, flipped to RX and called once
+ * per sample after BENCH_WARMUP untimed calls, so go() must be safe to
+ * run repeatedly and must not block (no message boxes).
+ *
+ * --csv prints a single line for build drivers (TransformCost.java):
+ *   size,samples,min_ns,p50_ns,p90_ns,p99_ns,p50_cycles
+ *
+ * Compile (host tool):
+ *   x86_64-w64-mingw32-gcc -O2 pic_runner.c -o pic_runner.exe
+ */
+
+#include <windows.h>
+#include <stdio.h>
+#include <string.h>
+#include "bench_timing.h"
+
+#define DEFAULT_SAMPLES 200
+
+typedef void (*PIC_ENTRY)(void);
+
+static BYTE* read_blob(const char* path, DWORD* size) {
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    DWORD length = GetFileSize(file, NULL);
+    BYTE* data = NULL;
+    DWORD read = 0;
+
+    if (length != INVALID_FILE_SIZE && length > 0) {
+        data = (BYTE*)malloc(length);
+        if (data && (!ReadFile(file, data, length, &read, NULL) || read != length)) {
+            free(data);
+            data = NULL;
+        }
+    }
+
+    CloseHandle(file);
+    *size = length;
+    return data;
+}
+
+// Copy into fresh memory and make it executable (never RWX)
+static PIC_ENTRY map_blob(const BYTE* data, DWORD size) {
+    BYTE* code = (BYTE*)VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!code) return NULL;
+
+    memcpy(code, data, size);
+
+    DWORD old;
+    if (!VirtualProtect(code, size, PAGE_EXECUTE_READ, &old)) {
+        VirtualFree(code, 0, MEM_RELEASE);
+        return NULL;
+    }
+
+    FlushInstructionCache(GetCurrentProcess(), code, size);
+    return (PIC_ENTRY)code;
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    DWORD samples = DEFAULT_SAMPLES;
+    BOOL csv = FALSE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = TRUE;
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            samples = (DWORD)strtoul(argv[i], NULL, 10);
+        }
+    }
+
+    if (!path || samples == 0) {
+        fprintf(stderr, "usage: %s <pic.bin> [samples] [--csv]\n", argv[0]);
+        return 1;
+    }
+
+    DWORD size;
+    BYTE* data = read_blob(path, &size);
+    if (!data) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 1;
+    }
+
+    PIC_ENTRY entry = map_blob(data, size);
+    free(data);
+
+    double* cycles = (double*)malloc(samples * sizeof(double));
+    if (!entry || !cycles) {
+        fprintf(stderr, "cannot map %s\n", path);
+        return 1;
+    }
+
+    bench_calibrate();
+
+    for (DWORD s = 0; s < BENCH_WARMUP + samples; s++) {
+        unsigned long long start = bench_ticks();
+        entry();
+        unsigned long long end = bench_ticks();
+
+        if (s >= BENCH_WARMUP) {
+            cycles[s - BENCH_WARMUP] = (double)(end - start);
+        }
+    }
+
+    BENCH_RESULT result;
+    bench_summarize(cycles, samples, &result);
+
+    if (csv) {
+        printf("%lu,%lu,%.1f,%.1f,%.1f,%.1f,%.0f\n",
+               (unsigned long)size, (unsigned long)samples,
+               result.min_ns, result.p50_ns, result.p90_ns, result.p99_ns,
+               result.p50_cycles);
+    } else {
+        printf("%s: %lu bytes, %lu samples\n", path, (unsigned long)size, (unsigned long)samples);
+        printf("  min %.1f ns  p50 %.1f ns  p90 %.1f ns  p99 %.1f ns  (%.0f cycles p50)\n",
+               result.min_ns, result.p50_ns, result.p90_ns, result.p99_ns,
+               result.p50_cycles);
+    }
+
+    free(cycles);
+    return 0;
+}